@@ -18,6 +18,11 @@ file
     : shaderTypeStatement topLevelStatement* EOF
     ;
 
+// Top-level module unit (imported files)
+moduleFile
+    : shaderImportStatement* shaderStructDefinition* EOF
+    ;
+
 // Shader type statement
 shaderTypeStatement
     : '@shader' type=IDENTIFIER ';'
@@ -25,15 +30,27 @@ shaderTypeStatement
 
 // Shader top level statements
 topLevelStatement
-    : shaderStructDefinition
+    : shaderImportStatement
+    | shaderStructDefinition
     | shaderInputOutputStatement
     | shaderUniformStatement
+    | shaderPushStatement
     | shaderBindingStatement
     | shaderLocalStatement
     | shaderSubpassInputStatement
+    | shaderDepthStatement
+    | shaderWorkgroupStatement
+    | shaderSharedStatement
+    | shaderConstantStatement
+    | shaderUserFunction
     | shaderStageFunction
     ;
 
+// Shader import statement, for loading declarations from a module file
+shaderImportStatement
+    : '@import' path=STRING_LITERAL ';'
+    ;
+
 // Shader struct statement, for defining new POD struct types
 shaderStructDefinition
     : '@struct' name=IDENTIFIER '{' (variableDeclaration ';')+ '}' ';'
@@ -41,7 +58,7 @@ shaderStructDefinition
 
 // Shader input or output declaration
 shaderInputOutputStatement
-    : io=('in'|'out') '(' index=INTEGER_LITERAL ')' variableDeclaration ';'
+    : io=('in'|'out') '(' index=INTEGER_LITERAL (',' attrs+=IDENTIFIER)* ')' variableDeclaration ';'
     ;
 
 // Shader uniform statement
@@ -49,6 +66,11 @@ shaderUniformStatement
     : 'uniform' variableDeclaration ';'
     ;
 
+// Shader push constant statement
+shaderPushStatement
+    : 'push' variableDeclaration ';'
+    ;
+
 // Shader binding declaration
 shaderBindingStatement
     : 'bind' '(' slot=INTEGER_LITERAL ')' variableDeclaration ';'
@@ -64,11 +86,41 @@ shaderSubpassInputStatement
     : 'passinput' '(' index=INTEGER_LITERAL ')' format=IDENTIFIER name=IDENTIFIER ';'
     ;
 
+// Shader fragment depth mode statement
+shaderDepthStatement
+    : '@depth' mode=IDENTIFIER ';'
+    ;
+
+// Compute shader workgroup size statement (sizes are literals or specialization constant names)
+shaderWorkgroupStatement
+    : '@workgroup' '(' sizeX=workgroupSize (',' sizeY=workgroupSize (',' sizeZ=workgroupSize)?)? ')' ';'
+    ;
+workgroupSize
+    : INTEGER_LITERAL
+    | IDENTIFIER
+    ;
+
+// Compute shader workgroup shared variable statement
+shaderSharedStatement
+    : 'shared' variableDeclaration ';'
+    ;
+
+// Shader specialization constant statement
+shaderConstantStatement
+    : 'const' '(' id=INTEGER_LITERAL ')' variableDeclaration '=' value=scalarLiteral ';'
+    ;
+
 // Shader stage function statement
 shaderStageFunction
     : '@' stage=IDENTIFIER statementBlock
     ;
 
+// Shader user-defined function, with an optional inline/noinline annotation
+shaderUserFunction
+    : '@func' ('(' attr=IDENTIFIER ')')? retType=IDENTIFIER name=IDENTIFIER
+        '(' (params+=variableDeclaration (',' params+=variableDeclaration)*)? ')' statementBlock
+    ;
+
 
 /////
 // Statements
@@ -79,6 +131,7 @@ statement
     | ifStatement
     | forLoopStatement
     | controlStatement ';'
+    | functionCall ';'
     ;
 statementBlock
     : '{' statement* '}'
@@ -128,7 +181,7 @@ forLoopStatement
 
 // Control Flow Statement
 controlStatement
-    : 'break' | 'continue' | 'return' | 'discard'
+    : 'break' | 'continue' | 'return' value=expression? | 'discard'
     ;
 
 
@@ -161,9 +214,10 @@ atom
     | IDENTIFIER                                              # NameAtom
     ;
 
-// Function or constructor call
+// Function or constructor call (atomic functions operate on an lvalue)
 functionCall
-    : name=IDENTIFIER '(' args+=expression (',' args+=expression )* ')'
+    : name=IDENTIFIER '(' (args+=expression (',' args+=expression )*)? ')'
+    | name=ATOMIC_FUNCTION '(' dst=lvalue (',' args+=expression)+ ')'
     ;
 
 // Scalar literal (number or bool)
@@ -15,34 +15,52 @@ BOOLEAN_LITERAL : 'true' | 'false' ;
 // Keywords
 KW_BIND       : 'bind' ;
 KW_BREAK      : 'break' ;
+KW_CONST      : 'const' ;
 KW_CONTINUE   : 'continue' ;
+KW_DEPTH      : '@depth' ;
 KW_DISCARD    : 'discard' ;
 KW_ELIF       : 'elif' ;
 KW_ELSE       : 'else' ;
 KW_FLAT       : 'flat' ;
 KW_FOR        : 'for' ;
+KW_FUNC       : '@func' ;
 KW_IF         : 'if' ;
+KW_IMPORT     : '@import' ;
 KW_IN         : 'in' ;
 KW_LOCAL      : 'local' ;
 KW_OUT        : 'out' ;
+KW_PUSH       : 'push' ;
 KW_RETURN     : 'return' ;
 KW_SHADER     : '@shader' ;
+KW_SHARED     : 'shared' ;
 KW_PASSINPUT  : 'passinput' ;
 KW_STRUCT     : '@struct' ;
 KW_UNIFORM    : 'uniform' ;
+KW_WORKGROUP  : '@workgroup' ;
 
-// Number literals
+// Number literals (with optional 16-bit 's', 'us' and 'hf' suffixes)
 INTEGER_LITERAL
-    : '-'? DecimalLiteral [uU]?
+    : '-'? DecimalLiteral ([uU] [sS]? | [sS])?
     | HexLiteral
     ;
 FLOAT_LITERAL
-    : '-'? DecimalLiteral ExponentPart
-    | '-'? DecimalLiteral '.' DecimalLiteral? ExponentPart?
+    : '-'? DecimalLiteral ExponentPart HalfSuffix?
+    | '-'? DecimalLiteral '.' DecimalLiteral? ExponentPart? HalfSuffix?
     ;
 fragment DecimalLiteral : DigitChar+ ;
 fragment HexLiteral     : '0x' HexDigitChar+ ;
 fragment ExponentPart   : [eE] ('-'|'+')? DigitChar+ ;
+fragment HalfSuffix     : [hH] [fF] ;
+
+// String literals (only used for import paths)
+STRING_LITERAL
+    : '"' ~["\r\n]* '"'
+    ;
+
+// Atomic functions (these take an lvalue as the first argument, so they must be distinct from identifiers)
+ATOMIC_FUNCTION
+    : 'atomic' ('Add'|'Min'|'Max'|'And'|'Or'|'Xor'|'Exchange'|'CompSwap')
+    ;
 
 // Identifiers, valid for variable and type names, and built-ins
 IDENTIFIER
@@ -10,6 +10,7 @@
 
 #include <shaderc/shaderc.hpp>
 
+#include <algorithm>
 #include <fstream>
 
 
@@ -22,6 +23,22 @@ inline static void file_write(std::ofstream& file, const T& val) {
 	file.write(reinterpret_cast<const char*>(&val), sizeof(T));
 }
 
+// ====================================================================================================================
+static void write_struct_layout(std::ofstream& file, const StructType* sType)
+{
+	file_write(file, uint32(sType->members().size()));
+	for (uint32 i = 0; i < sType->members().size(); ++i) {
+		const auto& mem = sType->members()[i];
+		const auto offset = sType->offsets()[i];
+
+		file_write(file, uint8(mem.name.size()));
+		file.write(mem.name.data(), mem.name.size());
+		file_write(file, uint16(offset));
+		struct_member_record rec{ mem };
+		file_write(file, rec);
+	}
+}
+
 // ====================================================================================================================
 // Needed to make sure the values fit in reflection info
 static_assert(Shader::MAX_NAME_LENGTH <= UINT8_MAX);
@@ -31,6 +48,9 @@ static_assert(Shader::MAX_VERTEX_ATTRIBS <= UINT8_MAX);
 static_assert(Shader::MAX_FRAGMENT_OUTPUTS <= UINT8_MAX);
 static_assert(Shader::MAX_BINDINGS <= UINT8_MAX);
 static_assert(Shader::MAX_SUBPASS_INPUTS <= UINT8_MAX);
+static_assert(Shader::MAX_WORKGROUP_INVOCATIONS <= UINT16_MAX);
+static_assert(Shader::MAX_SHARED_SIZE <= UINT16_MAX);
+static_assert(Shader::MAX_CONSTANTS < UINT8_MAX);
 static_assert(uint32(BaseType::MAX) <= UINT8_MAX);
 static_assert(uint32(TexelRank::MAX) <= UINT8_MAX);
 static_assert(uint32(TexelType::MAX) <= UINT8_MAX);
@@ -76,7 +96,8 @@ bool Compiler::compileStage(const StageGenerator& gen)
 		(stage == ShaderStages::Vertex) ? shaderc_vertex_shader :
 		(stage == ShaderStages::TessControl) ? shaderc_tess_control_shader :
 		(stage == ShaderStages::TessEval) ? shaderc_tess_evaluation_shader :
-		(stage == ShaderStages::Geometry) ? shaderc_geometry_shader : shaderc_fragment_shader;
+		(stage == ShaderStages::Geometry) ? shaderc_geometry_shader :
+		(stage == ShaderStages::Fragment) ? shaderc_fragment_shader : shaderc_compute_shader;
 	shaderc::Compiler compiler{ };
 	const auto result = compiler.CompileGlslToSpv(
 		gen.source().str(),
@@ -105,6 +126,12 @@ bool Compiler::compileStage(const StageGenerator& gen)
 
 // ====================================================================================================================
 void Compiler::writeOutput() const
+{
+	writeOutput(options_->outputFile());
+}
+
+// ====================================================================================================================
+void Compiler::writeOutput(const string& outputFile) const
 {
 	if (options_->noCompile()) {
 		return;
@@ -112,27 +139,50 @@ void Compiler::writeOutput() const
 
 	const auto& info = shader_->info();
 
-	// Open file and write magic number ("VBC" + uint8(1) version)
-	std::ofstream file{ options_->outputFile(), std::ofstream::binary | std::ofstream::trunc };
-	file << "VBC" << uint8(1);
+	// Open file and write magic number ("VBC" + uint8(14) version)
+	std::ofstream file{ outputFile, std::ofstream::binary | std::ofstream::trunc };
+	file << "VBC" << uint8(14);
+
+	// Write the shader type (1 = graphics, 2 = compute)
+	file << uint8(info.kind());
 
-	// Write the shader type (1 = graphics)
-	file << uint8(1);
+	// Write the shader flags and fragment depth mode
+	file_write(file, uint32(info.flags()));
+	file_write(file, uint8(info.depthMode()));
+
+	// Write the used subgroup operations (VkSubgroupFeatureFlags bits)
+	file_write(file, uint8(info.subgroupOps()));
 
 	// Write the bytecode sizes
-	uint16 bytecode[5] {
+	uint16 bytecode[6] {
 		uint16(bool(info.stageMask() & ShaderStages::Vertex) ? bytecodes_.at(ShaderStages::Vertex).size() : 0),
 		uint16(bool(info.stageMask() & ShaderStages::TessControl) ? bytecodes_.at(ShaderStages::TessControl).size() : 0),
 		uint16(bool(info.stageMask() & ShaderStages::TessEval) ? bytecodes_.at(ShaderStages::TessEval).size() : 0),
 		uint16(bool(info.stageMask() & ShaderStages::Geometry) ? bytecodes_.at(ShaderStages::Geometry).size() : 0),
-		uint16(bool(info.stageMask() & ShaderStages::Fragment) ? bytecodes_.at(ShaderStages::Fragment).size() : 0)
+		uint16(bool(info.stageMask() & ShaderStages::Fragment) ? bytecodes_.at(ShaderStages::Fragment).size() : 0),
+		uint16(bool(info.stageMask() & ShaderStages::Compute) ? bytecodes_.at(ShaderStages::Compute).size() : 0)
 	};
 	file_write(file, bytecode);
 
 	// Write table sizes
 	file_write(file, options_->tableSizes());
 
-	// Write vertex inputs
+	// Write compute info (workgroup size, workgroup size constant ids, and shared memory size)
+	if (info.isCompute()) {
+		const auto wgSize = info.workgroupSize();
+		const auto wgIds = info.workgroupSizeIds();
+		for (uint32 i = 0; i < 3; ++i) {
+			file_write(file, uint16(wgSize[i]));
+		}
+		for (uint32 i = 0; i < 3; ++i) {
+			file_write(file, uint8((wgIds[i] == UINT32_MAX) ? UINT8_MAX : wgIds[i])); // UINT8_MAX = literal size
+		}
+		file_write(file, uint16(info.getSharedSize()));
+	}
+
+	// Write vertex inputs (with the per-vertex and per-instance strides)
+	file_write(file, uint16(info.vertexStride()));
+	file_write(file, uint16(info.instanceStride()));
 	file_write(file, uint32(info.inputs().size()));
 	for (const auto& input : info.inputs()) {
 		interface_record rec{ input };
@@ -160,22 +210,34 @@ void Compiler::writeOutput() const
 		
 		file_write(file, uint16(sType->size()));
 		file_write(file, uint16(unif.stageMask));
-		file_write(file, uint32(sType->members().size()));
-		for (uint32 i = 0; i < sType->members().size(); ++i) {
-			const auto& mem = sType->members()[i];
-			const auto offset = sType->offsets()[i];
-
-			file_write(file, uint8(mem.name.size()));
-			file.write(mem.name.data(), mem.name.size());
-			file_write(file, uint16(offset));
-			struct_member_record rec{ mem };
-			file_write(file, rec);
-		}
+		file_write(file, uint16(info.getPushUniformOffset())); // Push constant offset (if UniformPushConstant)
+		write_struct_layout(file, sType);
 	}
 	else {
 		file_write(file, uint16(0));
 	}
 
+	// Write push constant info
+	if (info.hasPushConstant()) {
+		const auto& push = info.pushConstant();
+		const auto sType = push.type->userStruct.type;
+
+		file_write(file, uint16(sType->size()));
+		file_write(file, uint16(push.stageMask));
+		file_write(file, uint16(info.getPushConstantOffset())); // Push constant offset
+		write_struct_layout(file, sType);
+	}
+	else {
+		file_write(file, uint16(0));
+	}
+
+	// Write buffer struct layouts (in binding order, only for bindings with struct types)
+	for (const auto& binding : info.bindings()) {
+		if (binding.type->hasStructType()) {
+			write_struct_layout(file, binding.type->buffer.structType->userStruct.type);
+		}
+	}
+
 	// Write subpass inputs
 	file_write(file, uint32(info.subpassInputs().size()));
 	for (const auto& spi : info.subpassInputs()) {
@@ -183,6 +245,24 @@ void Compiler::writeOutput() const
 		file_write(file, spi);
 	}
 
+	// Write packed local slot count
+	file_write(file, uint32(info.getLocalSlotCount()));
+
+	// Write specialization constants (name, id, base type, and raw default value), skipping baked constants
+	const auto constCount = std::count_if(info.constants().begin(), info.constants().end(),
+		[](const ConstantVariable& cnst) { return !cnst.baked; });
+	file_write(file, uint32(constCount));
+	for (const auto& cnst : info.constants()) {
+		if (cnst.baked) {
+			continue;
+		}
+		file_write(file, uint8(cnst.name.size()));
+		file.write(cnst.name.data(), cnst.name.size());
+		file_write(file, uint8(cnst.id));
+		file_write(file, uint8(cnst.type->baseType));
+		file_write(file, cnst.value);
+	}
+
 	// Write bytecodes
 	if (bool(info.stageMask() & ShaderStages::Vertex)) {
 		const auto& bc = bytecodes_.at(ShaderStages::Vertex);
@@ -204,6 +284,10 @@ void Compiler::writeOutput() const
 		const auto& bc = bytecodes_.at(ShaderStages::Fragment);
 		file.write(reinterpret_cast<const char*>(bc.data()), bc.size() * sizeof(uint32));
 	}
+	if (bool(info.stageMask() & ShaderStages::Compute)) {
+		const auto& bc = bytecodes_.at(ShaderStages::Compute);
+		file.write(reinterpret_cast<const char*>(bc.data()), bc.size() * sizeof(uint32));
+	}
 }
 
 // ====================================================================================================================
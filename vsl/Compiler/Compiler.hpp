@@ -27,6 +27,7 @@ public:
 
 	bool compileStage(const StageGenerator& gen);
 	void writeOutput() const;
+	void writeOutput(const string& outputFile) const; // Used to write the same bytecode for multiple variants
 
 private:
 	bool writeStageBytecode(ShaderStages stage);
@@ -18,32 +18,58 @@ namespace vsl
 // Used as a known layout object to write interface variable info to shader file
 struct interface_record final
 {
-	interface_record() : location{}, baseType{}, dims{}, arraySize{}, _pad0_{} { }
+	interface_record() 
+		: location{}, baseType{}, dims{}, arraySize{}, perInstance{}, offset{}, format{}, elementSize{} 
+	{ }
 	interface_record(const InterfaceVariable& var)
 		: location{ uint8(var.location) }
 		, baseType{ uint8(var.type->baseType) }
 		, dims{ uint8(var.type->numeric.dims[0]), uint8(var.type->numeric.dims[1]) }
 		, arraySize{ uint8(var.arraySize) }
-		, _pad0_{ }
-	{ }
+		, perInstance{ uint8(var.perInstance ? 1 : 0) }
+		, offset{ uint16(var.offset) }
+		, format{}
+		, elementSize{ uint8(var.elementSize()) }
+	{
+		if (var.format) {
+			format.texelType = uint8(var.format->type);
+			format.texelSize = uint8(var.format->size);
+			format.texelCount = uint8(var.format->count);
+		}
+		else {
+			format.texelType = uint8(var.type->isFloat() ? TexelType::Float : 
+				var.type->isSigned() ? TexelType::Signed : TexelType::Unsigned);
+			format.texelSize = uint8(var.type->numeric.size);
+			format.texelCount = uint8(var.type->numeric.dims[0]);
+		}
+	}
 
 	uint8 location;
 	uint8 baseType;
 	uint8 dims[2];
 	uint8 arraySize;
-	uint8 _pad0_[3];
+	uint8 perInstance; // Vertex input rate (0 = vertex, 1 = instance)
+	uint16 offset;     // Offset within the vertex (or instance) data
+	struct {
+		uint8 texelType;
+		uint8 texelSize;
+		uint8 texelCount;
+	} format;          // Storage format (per matrix column for matrix types)
+	uint8 elementSize; // Storage size of one array element
 }; // struct interface_record
-static_assert(sizeof(interface_record) == 8);
+static_assert(sizeof(interface_record) == 12);
 
 // Used as a known layout object to write binding info to a shader file
 struct binding_record final
 {
-	binding_record() : slot{}, baseType{}, stageMask{}, image{} { }
+	binding_record() : slot{}, baseType{}, stageMask{}, image{}, readMask{}, writeMask{} { }
 	binding_record(const BindingVariable& var)
 		: slot{ uint8(var.slot) }
 		, baseType{ uint8(var.type->baseType) }
 		, stageMask{ uint16(var.stageMask) }
 		, image{}
+		, readMask{ uint16(var.readMask) }
+		, writeMask{ uint16(var.writeMask) }
 	{
 		if (var.type->isTexelType()) {
 			image.rank = uint8(var.type->texel.rank);
@@ -70,8 +96,10 @@ struct binding_record final
 			uint16 size;
 		} buffer;
 	};
+	uint16 readMask;  // Stages that read the binding
+	uint16 writeMask; // Stages that write the binding
 }; // struct binding_record
-static_assert(sizeof(binding_record) == 8);
+static_assert(sizeof(binding_record) == 12);
 
 // Used as a known layout object to write subpass input info to a shader file
 struct subpass_input_record final
@@ -92,18 +120,27 @@ static_assert(sizeof(subpass_input_record) == 4);
 // Used as a known layout object to write struct members
 struct struct_member_record final
 {
-	struct_member_record() : baseType{}, dims{}, arraySize{} { }
+	struct_member_record() : baseType{}, size{}, dims{}, arraySize{}, elementSize{} { }
 	struct_member_record(const StructType::Member& mem)
 		: baseType{ uint8(mem.type->baseType) }
-		, dims{ uint8(mem.type->numeric.dims[0]), uint8(mem.type->numeric.dims[1]) }
+		, size{ uint8(mem.type->isBufferPtr() ? 8 : mem.type->numeric.size) }
+		, dims{ 1, 1 }
 		, arraySize{ uint8(mem.arraySize) }
-	{ }
+		, elementSize{ uint8(mem.type->getLayoutSize()) }
+	{
+		if (!mem.type->isBufferPtr()) {
+			dims[0] = uint8(mem.type->numeric.dims[0]);
+			dims[1] = uint8(mem.type->numeric.dims[1]);
+		}
+	}
 
 	uint8 baseType;
+	uint8 size;        // Size of each component in bytes
 	uint8 dims[2];
 	uint8 arraySize;
+	uint8 elementSize; // Size of each array element in bytes
 }; // struct struct_memver_record
-static_assert(sizeof(struct_member_record) == 4);
+static_assert(sizeof(struct_member_record) == 6);
 
 #pragma pack(pop)
 
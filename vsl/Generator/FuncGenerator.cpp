@@ -7,6 +7,8 @@
 #include "./FuncGenerator.hpp"
 #include "./NameGeneration.hpp"
 
+#include <algorithm>
+
 
 namespace vsl
 {
@@ -16,14 +18,17 @@ static const string CRLF{ "\r\n" };
 
 
 // ====================================================================================================================
-FuncGenerator::FuncGenerator(ShaderStages stage)
+FuncGenerator::FuncGenerator(ShaderStages stage, bool relaxedPrecision)
 	: name_{ "main" }
 	, stage_{ stage }
+	, relaxedPrecision_{ relaxedPrecision }
 	, source_{ }
 	, indent_{ "\t" }
 	, uid_{ 0 }
 	, bindingMask_{ 0 }
 	, spiMask_{ 0 }
+	, functions_{ }
+	, definedFunctions_{ }
 {
 	
 }
@@ -37,13 +42,13 @@ FuncGenerator::~FuncGenerator()
 // ====================================================================================================================
 void FuncGenerator::emitDeclaration(const ShaderType* type, const string& name)
 {
-	source_ << indent_ << type->getGLSLName() << " " << name << ";" << CRLF;
+	source_ << indent_ << getTypeName(type) << " " << name << ";" << CRLF;
 }
 
 // ====================================================================================================================
 void FuncGenerator::emitVariableDefinition(const ShaderType* type, const string& name, const string& value)
 {
-	source_ << indent_ << type->getGLSLName() << " " << name << " = " << value << ";" << CRLF;
+	source_ << indent_ << getTypeName(type) << " " << name << " = " << value << ";" << CRLF;
 }
 
 // ====================================================================================================================
@@ -55,7 +60,7 @@ void FuncGenerator::emitAssignment(const string& left, const string& op, const s
 // ====================================================================================================================
 string FuncGenerator::emitTempDefinition(const ShaderType* type, const string& value)
 {
-	source_ << indent_ << type->getGLSLName() << " _t" << (uid_++) << "_ = " << value << ";" << CRLF;
+	source_ << indent_ << getTypeName(type) << " _t" << (uid_++) << "_ = " << value << ";" << CRLF;
 	return mkstr("_t%u_", uid_ - 1);
 }
 
@@ -115,6 +120,12 @@ void FuncGenerator::emitControlStatement(const string& keyword)
 	source_ << indent_ << keyword << ";" << CRLF;
 }
 
+// ====================================================================================================================
+void FuncGenerator::emitCall(const string& call)
+{
+	source_ << indent_ << call << ";" << CRLF;
+}
+
 // ====================================================================================================================
 void FuncGenerator::emitBindingIndex(uint32 index)
 {
@@ -131,4 +142,63 @@ void FuncGenerator::emitBindingIndex(uint32 index)
 	source_ << saved;
 }
 
+// ====================================================================================================================
+void FuncGenerator::emitFunctionDefinition(const string& name, const string& definition)
+{
+	if (std::find(definedFunctions_.begin(), definedFunctions_.end(), name) != definedFunctions_.end()) {
+		return; // Already emitted
+	}
+	definedFunctions_.push_back(name);
+
+	functions_ << definition << CRLF;
+}
+
+// ====================================================================================================================
+string FuncGenerator::emitInlineCall(uint32 uid, const ShaderType* retType,
+	const std::vector<std::pair<const ShaderType*, string>>& params, const std::vector<string>& args,
+	const string& body)
+{
+	// Evaluate the arguments first, so the parameter names cannot shadow names used in the arguments
+	std::vector<string> argNames{};
+	for (size_t i = 0; i < params.size(); ++i) {
+		argNames.push_back(mkstr("_a%u_%u_", uid, uint32(i)));
+		emitVariableDefinition(params[i].first, argNames.back(), args[i]);
+	}
+	const auto retName = retType->isVoid() ? string{} : mkstr("_r%u_", uid);
+	if (!retName.empty()) {
+		emitDeclaration(retType, retName);
+	}
+
+	// Emit the body in its own block, binding the parameters and result
+	source_ << indent_ << "{" << CRLF;
+	indent_ += '\t';
+	for (size_t i = 0; i < params.size(); ++i) {
+		emitVariableDefinition(params[i].first, params[i].second, argNames[i]);
+	}
+	std::istringstream lines{ body };
+	string line{};
+	while (std::getline(lines, line)) {
+		if (!line.empty() && (*line.rbegin() == '\r')) {
+			line.pop_back();
+		}
+		for (auto idx = line.find("_return_"); idx != string::npos; idx = line.find("_return_", idx)) {
+			line.replace(idx, 8, retName);
+		}
+		source_ << indent_ << ((line[0] == '\t') ? line.substr(1) : line) << CRLF; // Body has one level of indent
+	}
+	closeBlock();
+
+	return retName;
+}
+
+// ====================================================================================================================
+string FuncGenerator::getTypeName(const ShaderType* type) const
+{
+	// Only 32-bit floats are relaxed, integer math and explicit 16-bit types keep their declared precision
+	if (relaxedPrecision_ && type->isFloat() && (type->numeric.size == 4)) {
+		return "mediump " + type->getGLSLName();
+	}
+	return type->getGLSLName();
+}
+
 } // namespace vsl
@@ -17,7 +17,7 @@ namespace vsl
 class FuncGenerator final
 {
 public:
-	FuncGenerator(ShaderStages stage);
+	FuncGenerator(ShaderStages stage, bool relaxedPrecision);
 	~FuncGenerator();
 
 	/* Assignment */
@@ -36,21 +36,35 @@ public:
 
 	/* Other */
 	void emitControlStatement(const string& keyword);
+	void emitCall(const string& call);
 
 	/* Binding */
 	void emitBindingIndex(uint32 index);
 
+	/* User Functions */
+	void emitFunctionDefinition(const string& name, const string& definition); // Only emitted once per function
+	string emitInlineCall(uint32 uid, const ShaderType* retType,
+		const std::vector<std::pair<const ShaderType*, string>>& params, const std::vector<string>& args,
+		const string& body);
+
 	/* Source Access */
 	inline const std::stringstream& source() const { return source_; }
+	inline const std::stringstream& functions() const { return functions_; }
+
+private:
+	string getTypeName(const ShaderType* type) const;
 
 private:
 	const string name_;
 	const ShaderStages stage_;
+	const bool relaxedPrecision_;
 	std::stringstream source_;
 	string indent_;
 	uint32 uid_;
 	uint32 bindingMask_;
 	uint32 spiMask_;
+	std::stringstream functions_;
+	std::vector<string> definedFunctions_;
 
 	VSL_NO_COPY(FuncGenerator)
 	VSL_NO_MOVE(FuncGenerator)
@@ -37,6 +37,7 @@ string NameGeneration::GetBindingTableName(const ShaderType* type)
 		const auto ftxt = type->texel.format->getVSLName();
 		basename = "rwtexels_" + ftxt;
 	} break;
+	case BaseType::BufferPtr: throw std::runtime_error("COMPILER BUG - BufferPtr does not have a binding table");
 	}
 
 	// Create final name
@@ -61,14 +62,30 @@ string NameGeneration::GetGLSLBuiltinName(const string& name)
 		{ "$DrawIndex", "gl_DrawIndex" },
 		{ "$VertexBase", "gl_BaseVertex" },
 		{ "$InstanceBase", "gl_BaseInstance" },
+		{ "$ViewIndex", "gl_ViewIndex" },
 
 		{ "$Position", "gl_Position" },
 		{ "$PointSize", "gl_PointSize" },
+		{ "$PrimitiveShadingRate", "gl_PrimitiveShadingRateEXT" },
 
 		{ "$FragCoord", "gl_FragCoord" },
 		{ "$FrontFacing", "gl_FrontFacing" },
 		{ "$PointCoord", "gl_PointCoord" },
-		{ "$PrimitiveID", "gl_PrimitiveID" }
+		{ "$PrimitiveID", "gl_PrimitiveID" },
+		{ "$ShadingRate", "gl_ShadingRateEXT" },
+		{ "$FragDepth", "gl_FragDepth" },
+
+		{ "$GlobalInvocationID", "gl_GlobalInvocationID" },
+		{ "$LocalInvocationID", "gl_LocalInvocationID" },
+		{ "$LocalInvocationIndex", "gl_LocalInvocationIndex" },
+		{ "$WorkgroupID", "gl_WorkGroupID" },
+		{ "$NumWorkgroups", "gl_NumWorkGroups" },
+		{ "$WorkgroupSize", "gl_WorkGroupSize" },
+		{ "$SubgroupID", "gl_SubgroupID" },
+		{ "$SubgroupCount", "gl_NumSubgroups" },
+
+		{ "$SubgroupSize", "gl_SubgroupSize" },
+		{ "$SubgroupInvocationID", "gl_SubgroupInvocationID" }
 	};
 
 	const auto it = NAMES.find(name);
@@ -8,6 +8,8 @@
 #include "./NameGeneration.hpp"
 #include "../Shader.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 
 
@@ -24,8 +26,9 @@ StageGenerator::StageGenerator(const CompileOptions* options, ShaderStages stage
 	, stage_{ stage }
 	, source_{ }
 	, generatedStructs_{ }
+	, declaredPointers_{ }
+	, generatedTables_{ }
 	, uid_{ 0 }
-	, localIdx_{ 0, 0 }
 {
 
 }
@@ -43,8 +46,49 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 	source_
 		<< "/// This file was generated by vslc, do not edit" << CRLF
 		<< "#version 450" << CRLF
-		<< "#extension GL_EXT_scalar_block_layout : require" << CRLF
-		<< CRLF;
+		<< "#extension GL_EXT_scalar_block_layout : require" << CRLF;
+	if (info.hasFlag(ShaderFlags::BufferReferences)) {
+		source_ << "#extension GL_EXT_buffer_reference : require" << CRLF;
+	}
+	if (info.hasFlag(ShaderFlags::Multiview)) {
+		source_ << "#extension GL_EXT_multiview : require" << CRLF;
+	}
+	if (info.hasFlag(ShaderFlags::PrimitiveShadingRate) || info.hasFlag(ShaderFlags::ShadingRateRead)) {
+		source_ << "#extension GL_EXT_fragment_shading_rate : require" << CRLF;
+	}
+	if (info.hasFlag(ShaderFlags::Storage16)) {
+		source_ << "#extension GL_EXT_shader_16bit_storage : require" << CRLF;
+	}
+	if (info.hasFlag(ShaderFlags::Storage8)) {
+		source_ << "#extension GL_EXT_shader_8bit_storage : require" << CRLF;
+	}
+	if (info.hasFlag(ShaderFlags::Arithmetic16) || info.hasFlag(ShaderFlags::Arithmetic8) ||
+			info.hasFlag(ShaderFlags::Storage16) || info.hasFlag(ShaderFlags::Storage8)) {
+		// Also needed for storage-only use, to allow implicit conversion of loaded values to 32-bit
+		source_ << "#extension GL_EXT_shader_explicit_arithmetic_types : require" << CRLF;
+	}
+	if (info.subgroupOps() != SubgroupOps::None) {
+		source_ << "#extension GL_KHR_shader_subgroup_basic : require" << CRLF;
+		if (info.hasSubgroupOps(SubgroupOps::Vote)) {
+			source_ << "#extension GL_KHR_shader_subgroup_vote : require" << CRLF;
+		}
+		if (info.hasSubgroupOps(SubgroupOps::Arithmetic)) {
+			source_ << "#extension GL_KHR_shader_subgroup_arithmetic : require" << CRLF;
+		}
+		if (info.hasSubgroupOps(SubgroupOps::Ballot)) {
+			source_ << "#extension GL_KHR_shader_subgroup_ballot : require" << CRLF;
+		}
+		if (info.hasSubgroupOps(SubgroupOps::Shuffle)) {
+			source_ << "#extension GL_KHR_shader_subgroup_shuffle : require" << CRLF;
+		}
+		if (info.hasSubgroupOps(SubgroupOps::ShuffleRelative)) {
+			source_ << "#extension GL_KHR_shader_subgroup_shuffle_relative : require" << CRLF;
+		}
+		if (info.hasSubgroupOps(SubgroupOps::Quad)) {
+			source_ << "#extension GL_KHR_shader_subgroup_quad : require" << CRLF;
+		}
+	}
+	source_ << CRLF;
 
 	// Emit the struct types
 	uint32 structCount{ 0 };
@@ -58,12 +102,73 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 		emitStruct(info.uniform().type->buffer.structType->userStruct.type);
 		++structCount;
 	}
-	if (structCount > 0) {
+	if (bool(info.pushConstant().stageMask & stage_)) {
+		emitStruct(info.pushConstant().type->userStruct.type);
+		++structCount;
+	}
+	for (const auto& ptr : info.bufferPtrTypes()) {
+		if (bool(ptr.stageMask & stage_)) {
+			declareBufferPtr(ptr.type);
+		}
+	}
+	for (size_t i = 0; i < declaredPointers_.size(); ++i) { // Can grow as pointed-to structs are emitted
+		emitBufferPtr(declaredPointers_[i]);
+	}
+	if ((structCount > 0) || !declaredPointers_.empty()) {
+		source_ << CRLF;
+	}
+
+	// Write the stage-specific layout
+	if (bool(stage_ & ShaderStages::Fragment) && info.hasFlag(ShaderFlags::EarlyFragmentTests)) {
+		source_ << "layout(early_fragment_tests) in;" << CRLF << CRLF;
+	}
+	if (bool(stage_ & ShaderStages::Fragment) && info.hasFlag(ShaderFlags::FragmentDepthWrite)) {
+		const auto mode = (info.depthMode() == DepthMode::None) ? DepthMode::Any : info.depthMode();
+		source_ << "layout(depth_" << DepthModeToStr(mode) << ") out float gl_FragDepth;" << CRLF << CRLF;
+	}
+	if (bool(stage_ & ShaderStages::Compute)) {
+		const auto wgSize = info.workgroupSize();
+		const auto wgIds = info.workgroupSizeIds();
+		const char* const DIMS[3]{ "x", "y", "z" };
+		source_ << "layout(";
+		for (uint32 i = 0; i < 3; ++i) {
+			source_ << ((i == 0) ? "" : ", ") << "local_size_" << DIMS[i] << " = " << wgSize[i];
+			if (wgIds[i] != UINT32_MAX) {
+				source_ << ", local_size_" << DIMS[i] << "_id = " << wgIds[i];
+			}
+		}
+		source_ << ") in;" << CRLF << CRLF;
+	}
+
+	// Write the specialization constants
+	uint32 constCount{ 0 };
+	for (const auto& cnst : info.constants()) {
+		if (bool(cnst.stageMask & stage_)) {
+			emitConstant(cnst);
+			++constCount;
+		}
+	}
+	if (constCount > 0) {
 		source_ << CRLF;
 	}
 
 	// Write the stage-specific I/O
-	if (bool(stage_ & ShaderStages::Vertex)) {
+	const auto vertexPulling = bool(stage_ & ShaderStages::Vertex) && info.hasFlag(ShaderFlags::VertexPulling);
+	if (vertexPulling) {
+		source_
+			<< "layout(set = 0, binding = 2, scalar) readonly buffer _VERTEX_BUFFER_ {" << CRLF
+			<< "\tuint _data_[];" << CRLF
+			<< "} _vertexBuffers_[" << options_->tableSizes().buffers << "];" << CRLF;
+		for (const auto& input : info.inputs()) {
+			source_ << input.type->getGLSLName() << ' ' << input.name;
+			if (input.arraySize > 1) {
+				source_ << '[' << input.arraySize << ']';
+			}
+			source_ << ';' << CRLF;
+		}
+		source_ << CRLF;
+	}
+	else if (bool(stage_ & ShaderStages::Vertex)) {
 		for (const auto& input : info.inputs()) {
 			emitVertexInput(input);
 		}
@@ -84,7 +189,7 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 	uint32 bindCount{ 0 };
 	for (const auto& bind : info.bindings()) {
 		if (bool(bind.stageMask & stage_)) {
-			emitBinding(bind);
+			emitBinding(bind, info);
 			++bindCount;
 		}
 	}
@@ -93,8 +198,9 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 	}
 
 	// Write the uniform
-	if (bool(info.uniform().stageMask & stage_)) {
-		emitBinding(info.uniform());
+	const auto pushUniform = info.hasFlag(ShaderFlags::UniformPushConstant);
+	if (bool(info.uniform().stageMask & stage_) && !pushUniform) {
+		emitBinding(info.uniform(), info);
 		source_ << CRLF;
 	}
 
@@ -106,12 +212,26 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 		source_ << CRLF;
 	}
 
-	// Write the binding indices
-	if (bindCount > 0) {
-		emitBindingIndices(info.getMaxBindingIndex());
+	// Write the shared variables
+	if (bool(stage_ & ShaderStages::Compute) && !info.sharedVariables().empty()) {
+		for (const auto& shared : info.sharedVariables()) {
+			source_ << "shared " << shared.type->getGLSLName() << ' ' << shared.name;
+			if (shared.arraySize > 1) {
+				source_ << '[' << shared.arraySize << ']';
+			}
+			source_ << ';' << CRLF;
+		}
+		source_ << CRLF;
 	}
 
-	// Write the locals (right now this is easy because we only support vert/frag)
+	// Write the push constants (binding indices, push constant, and promoted uniform)
+	const auto stagePush = bool(info.pushConstant().stageMask & stage_);
+	const auto stageUniform = pushUniform && bool(info.uniform().stageMask & stage_);
+	if ((bindCount > 0) || vertexPulling || stagePush || stageUniform) {
+		emitPushConstants(info, (bindCount > 0), vertexPulling, stagePush, stageUniform);
+	}
+
+	// Write the locals (compute shaders never have locals)
 	if (!info.locals().empty()) {
 		for (const auto& local : info.locals()) {
 			emitLocal(local);
@@ -119,8 +239,20 @@ void StageGenerator::generate(const FuncGenerator& func, const ShaderInfo& info)
 		source_ << CRLF;
 	}
 
-	// Write function text
-	source_ << "void main()" << CRLF << "{" << CRLF << func.source().str() << "}" << CRLF;
+	// Write the user functions used by the stage
+	source_ << func.functions().str();
+
+	// Write function text (with vertex fetches first)
+	source_ << "void main()" << CRLF << "{" << CRLF;
+	if (vertexPulling && !info.inputs().empty()) {
+		source_ 
+			<< "\tuint _vbase_ = uint(gl_VertexIndex) * " << (info.vertexStride() / 4) << "u;" << CRLF
+			<< "\tuint _ibase_ = uint(gl_InstanceIndex) * " << (info.instanceStride() / 4) << "u;" << CRLF;
+		for (const auto& input : info.inputs()) {
+			emitVertexPull(input);
+		}
+	}
+	source_ << func.source().str() << "}" << CRLF;
 }
 
 // ====================================================================================================================
@@ -156,6 +288,13 @@ void StageGenerator::emitStruct(const StructType* type)
 	}
 	generatedStructs_.push_back(type);
 
+	// Forward declare any new buffer pointer types (defined after all of the structs)
+	for (const auto& mem : type->members()) {
+		if (mem.type->isBufferPtr()) {
+			declareBufferPtr(mem.type->buffer.structType->userStruct.type);
+		}
+	}
+
 	// Emit the struct
 	source_ << "struct " << type->name() << "_t {" << CRLF;
 	for (uint32 i = 0; i < type->members().size(); ++i) {
@@ -171,6 +310,27 @@ void StageGenerator::emitStruct(const StructType* type)
 	source_ << "};" << CRLF;
 }
 
+// ====================================================================================================================
+void StageGenerator::declareBufferPtr(const StructType* type)
+{
+	if (std::find(declaredPointers_.begin(), declaredPointers_.end(), type) == declaredPointers_.end()) {
+		declaredPointers_.push_back(type);
+		source_ << "layout(buffer_reference) buffer " << type->name() << "_ptr;" << CRLF;
+	}
+}
+
+// ====================================================================================================================
+void StageGenerator::emitBufferPtr(const StructType* type)
+{
+	// The pointed-to struct must be defined before the reference block
+	emitStruct(type);
+
+	// Scalar layout, so the struct alignment (not the default 16) is the alignment of the address
+	source_
+		<< "layout(buffer_reference, scalar, buffer_reference_align = " << type->alignment() << ") buffer "
+		<< type->name() << "_ptr {" << CRLF << '\t' << type->name() << "_t _data_[];" << CRLF << "};" << CRLF;
+}
+
 // ====================================================================================================================
 void StageGenerator::emitVertexInput(const InterfaceVariable& var)
 {
@@ -181,6 +341,75 @@ void StageGenerator::emitVertexInput(const InterfaceVariable& var)
 	source_ << ';' << CRLF;
 }
 
+// ====================================================================================================================
+void StageGenerator::emitVertexPull(const InterfaceVariable& var)
+{
+	static const string SWIZZLES[4]{ ".x", ".xy", ".xyz", "" };
+
+	const auto type = var.type;
+	const auto format = var.format;
+	const auto compCount = type->numeric.dims[0] * type->numeric.dims[1];
+	const auto wordStr = [&var](uint32 byteOffset) -> string {
+		return var.perInstance
+			? mkstr("_vertexBuffers_[_bidx_.instanceBuffer]._data_[_ibase_ + %uu]", byteOffset / 4)
+			: mkstr("_vertexBuffers_[_bidx_.vertexBuffer]._data_[_vbase_ + %uu]", byteOffset / 4);
+	};
+
+	for (uint32 ai = 0; ai < var.arraySize; ++ai) {
+		const auto elemOffset = var.offset + (ai * var.elementSize());
+		source_ << '\t' << var.name;
+		if (var.arraySize > 1) {
+			source_ << '[' << ai << ']';
+		}
+		source_ << " = ";
+
+		if (format && format->isPacked()) {
+			// Packed formats are a single word, with the components shifted out
+			const auto word = wordStr(elemOffset);
+			if (format->type == TexelType::PackedUNorm) {
+				source_ 
+					<< "(vec4((uvec4(" << word << ") >> uvec4(0, 10, 20, 30)) & uvec4(0x3FFu, 0x3FFu, 0x3FFu, 0x3u)) / "
+					<< "vec4(1023, 1023, 1023, 3))";
+			}
+			else {
+				// 11- and 10-bit floats are halfs without the sign bit and with truncated mantissas
+				source_
+					<< "vec3(unpackHalf2x16(((" << word << " & 0x7FFu) << 4) | "
+					<< "(((" << word << " >> 11) & 0x7FFu) << 20)), "
+					<< "unpackHalf2x16(((" << word << " >> 22) & 0x3FFu) << 5).x)";
+			}
+			source_ << SWIZZLES[compCount - 1] << ';' << CRLF;
+		}
+		else if (format && (format->isNormlizedType() || (format->isFloat() && (format->size == 2)))) {
+			// Normalized and half values are unpacked from the containing word(s), then reduced to the used components
+			const auto prefix = format->isUNorm() ? "unpackUnorm" : format->isSNorm() ? "unpackSnorm" : "unpackHalf";
+			const auto shift = (elemOffset % 4) * 8;
+			const auto shiftStr = (shift != 0) ? mkstr(" >> %uu", shift) : string{};
+			if (format->size == 1) {
+				source_ << prefix << "4x8(" << wordStr(elemOffset) << shiftStr << ')';
+			}
+			else if (format->count == 4) {
+				source_ 
+					<< "vec4(" << prefix << "2x16(" << wordStr(elemOffset) << "), " 
+					<< prefix << "2x16(" << wordStr(elemOffset + 4) << "))";
+			}
+			else {
+				source_ << prefix << "2x16(" << wordStr(elemOffset) << shiftStr << ')';
+			}
+			source_ << SWIZZLES[compCount - 1] << ';' << CRLF;
+		}
+		else {
+			// 32-bit components are one word each, converted from uint
+			const auto conv = type->isFloat() ? "uintBitsToFloat" : type->isSigned() ? "int" : "";
+			source_ << type->getGLSLName() << '(';
+			for (uint32 ci = 0; ci < compCount; ++ci) {
+				source_ << ((ci == 0) ? "" : ", ") << conv << '(' << wordStr(elemOffset + (ci * 4)) << ')';
+			}
+			source_ << ");" << CRLF;
+		}
+	}
+}
+
 // ====================================================================================================================
 void StageGenerator::emitFragmentOutput(const InterfaceVariable& var)
 {
@@ -190,13 +419,21 @@ void StageGenerator::emitFragmentOutput(const InterfaceVariable& var)
 }
 
 // ====================================================================================================================
-void StageGenerator::emitBinding(const BindingVariable& bind)
+void StageGenerator::emitBinding(const BindingVariable& bind, const ShaderInfo& info)
 {
 	// Get shared binding info
 	uint32 set, binding, tableSize;
 	string tableName;
 	getBindingInfo(bind.type, &set, &binding, &tableSize, &tableName);
 
+	// Texel tables are shared by all bindings with the same type, and are only declared once
+	if (bind.type->isSampler() || bind.type->isROTexels() || bind.type->isImage() || bind.type->isRWTexels()) {
+		if (std::find(generatedTables_.begin(), generatedTables_.end(), tableName) != generatedTables_.end()) {
+			return;
+		}
+		generatedTables_.push_back(tableName);
+	}
+
 	// Generate based on type
 	if (bind.type->isSampler() || bind.type->isROTexels()) {
 		source_
@@ -206,11 +443,12 @@ void StageGenerator::emitBinding(const BindingVariable& bind)
 	else if (bind.type->isImage() || bind.type->isRWTexels()) {
 		auto extra = bind.type->texel.format->getGLSLName();
 		source_
-			<< "layout(set = " << set << ", binding = " << binding << ", " << extra << ") uniform "
+			<< "layout(set = " << set << ", binding = " << binding << ", " << extra << ") "
+			<< getMemoryQualifiers(bind, info) << "uniform "
 			<< bind.type->getGLSLName() << ' ' << tableName << '[' << tableSize << "];" << CRLF;
 	}
 	else if (bind.type->isRWBuffer() || bind.type->isROBuffer()) {
-		const auto access = bind.type->isROBuffer() ? "readonly " : "";
+		const auto access = bind.type->isROBuffer() ? "readonly " : getMemoryQualifiers(bind, info);
 		const auto name = bind.type->buffer.structType->userStruct.type->name() + "_t";
 		source_
 			<< "layout(set = " << set << ", binding = " << binding << ", scalar) " << access << "buffer _BUFFER"
@@ -235,30 +473,125 @@ void StageGenerator::emitSubpassInput(const SubpassInputVariable& var)
 }
 
 // ====================================================================================================================
-void StageGenerator::emitBindingIndices(uint32 maxIndex)
+void StageGenerator::emitPushConstants(const ShaderInfo& info, bool indices, bool vertexBuffer, bool push, 
+	bool uniform)
 {
-	const auto icount = (maxIndex + 2) / 2; // +1 to shift index->count, +1 to perform correct floor operation
+	const auto isize = info.getBindingIndicesSize();
 
-	source_ << "layout(push_constant) uniform _BINDING_INDICES_ {" << CRLF;
-	for (uint32 i = 0; i < icount; ++i) {
-		source_ << "\tuint index" << i << ";" << CRLF;
+	// Explicit offsets keep the layout identical in stages that do not use all of the members
+	source_ << "layout(push_constant, scalar) uniform _BINDING_INDICES_ {" << CRLF;
+	if (indices) {
+		for (uint32 i = 0; i < (isize / 4); ++i) {
+			source_ << "\tuint index" << i << ";" << CRLF;
+		}
+	}
+	if (vertexBuffer) {
+		source_ 
+			<< "\tlayout(offset = " << isize << ") uint vertexBuffer;" << CRLF
+			<< "\tlayout(offset = " << (isize + 4) << ") uint instanceBuffer;" << CRLF;
+	}
+	if (push) {
+		const auto name = info.pushConstant().type->userStruct.type->name() + "_t";
+		source_ 
+			<< "\tlayout(offset = " << info.getPushConstantOffset() << ") " << name << ' ' << info.pushConstant().name 
+			<< ';' << CRLF;
+	}
+	if (uniform) {
+		const auto name = info.uniform().type->buffer.structType->userStruct.type->name() + "_t";
+		source_ 
+			<< "\tlayout(offset = " << info.getPushUniformOffset() << ") " << name << ' ' << info.uniform().name 
+			<< ';' << CRLF;
 	}
 	source_ << "} _bidx_;" << CRLF << CRLF;
 }
 
+// ====================================================================================================================
+void StageGenerator::emitConstant(const ConstantVariable& var)
+{
+	string valStr{};
+	if (var.type->isBoolean()) {
+		valStr = var.value ? "true" : "false";
+	}
+	else if (var.type->isSigned()) {
+		valStr = mkstr("%d", int32(var.value));
+	}
+	else if (var.type->isUnsigned()) {
+		valStr = mkstr("%uu", var.value);
+	}
+	else {
+		float fval;
+		std::memcpy(&fval, &var.value, sizeof(float));
+		valStr = mkstr("%.9e", fval); // Exponent form is always a float literal, and 9 digits round-trips
+	}
+
+	if (!var.baked) {
+		source_ << "layout(constant_id = " << var.id << ") ";
+	}
+	source_ << "const " << var.type->getGLSLName() << ' ' << var.name << " = " << valStr << ';' << CRLF;
+}
+
 // ====================================================================================================================
 void StageGenerator::emitLocal(const LocalVariable& var)
 {
 	const auto dirstr = (var.pStage == stage_) ? "out" : "in";
-	const auto loc = (var.pStage == stage_) ? (localIdx_.out++) : (localIdx_.in++);
 
-	source_ << "layout(location = " << loc << ") " << dirstr << ' ';
+	source_ << "layout(location = " << var.location << ", component = " << var.component << ") " << dirstr << ' ';
 	if (var.isFlat) {
 		source_ << "flat ";
 	}
 	source_ << var.type->getGLSLName() << " _l" << dirstr << '_' << var.name << ";" << CRLF;
 }
 
+// ====================================================================================================================
+string StageGenerator::getMemoryQualifiers(const BindingVariable& bind, const ShaderInfo& info) const
+{
+	string quals{};
+
+	// Access qualifiers (stages that never touch the binding do not declare it, so one of these is always set)
+	auto reads = bind.isReadIn(stage_);
+	auto writes = bind.isWrittenIn(stage_);
+	if (bind.type->isImage() || bind.type->isRWTexels()) {
+		// The table is shared with all bindings of the same type, so merge their access
+		const auto tableName = NameGeneration::GetBindingTableName(bind.type);
+		for (const auto& other : info.bindings()) {
+			if ((other.type->isImage() || other.type->isRWTexels()) &&
+					(NameGeneration::GetBindingTableName(other.type) == tableName)) {
+				reads = reads || other.isReadIn(stage_);
+				writes = writes || other.isWrittenIn(stage_);
+			}
+		}
+	}
+	if (reads && !writes) {
+		quals += "readonly ";
+	}
+	else if (writes && !reads) {
+		quals += "writeonly ";
+	}
+
+	// Restrict is provable if no other binding used in this stage can alias the same memory
+	const auto isImageMemory = [](const ShaderType* type) { return type->isImage() || type->isSampler(); };
+	const auto isBufferMemory = [](const ShaderType* type) {
+		return type->isBufferType() || type->isROTexels() || type->isRWTexels();
+	};
+	const auto selfImage = isImageMemory(bind.type);
+	const auto vertexPulling = bool(stage_ & ShaderStages::Vertex) && info.hasFlag(ShaderFlags::VertexPulling);
+	if (!selfImage && (info.hasFlag(ShaderFlags::BufferReferences) || vertexPulling)) {
+		return quals; // Buffer references and the vertex buffer table can alias any buffer memory
+	}
+	const auto aliased = std::any_of(info.bindings().begin(), info.bindings().end(), 
+		[&](const BindingVariable& other) {
+			if ((other.slot == bind.slot) || !bool(other.stageMask & stage_)) {
+				return false;
+			}
+			return selfImage ? isImageMemory(other.type) : isBufferMemory(other.type);
+		});
+	if (!aliased) {
+		quals += "restrict ";
+	}
+
+	return quals;
+}
+
 // ====================================================================================================================
 void StageGenerator::getBindingInfo(const ShaderType* type, uint32* set, uint32* binding, uint32* tableSize, 
 	string* tableName)
@@ -277,6 +610,7 @@ void StageGenerator::getBindingInfo(const ShaderType* type, uint32* set, uint32*
 	case BaseType::ROTexels: *binding = 3; *tableSize = options_->tableSizes().roTexels; break;
 	case BaseType::RWTexels: *binding = 4; *tableSize = options_->tableSizes().rwTexels; break;
 	case BaseType::Uniform: *binding = 0; *tableSize = 0; break;
+	case BaseType::BufferPtr: throw std::runtime_error("COMPILER BUG - BufferPtr does not have binding info");
 	}
 }
 
@@ -31,13 +31,18 @@ public:
 
 private:
 	void emitStruct(const StructType* type);
+	void declareBufferPtr(const StructType* type);
+	void emitBufferPtr(const StructType* type);
 	void emitVertexInput(const InterfaceVariable& var);
+	void emitVertexPull(const InterfaceVariable& var);
 	void emitFragmentOutput(const InterfaceVariable& var);
-	void emitBinding(const BindingVariable& bind);
+	void emitBinding(const BindingVariable& bind, const ShaderInfo& info);
 	void emitSubpassInput(const SubpassInputVariable& var);
-	void emitBindingIndices(uint32 maxIndex);
+	void emitPushConstants(const ShaderInfo& info, bool indices, bool vertexBuffer, bool push, bool uniform);
+	void emitConstant(const ConstantVariable& var);
 	void emitLocal(const LocalVariable& var);
 
+	string getMemoryQualifiers(const BindingVariable& bind, const ShaderInfo& info) const;
 	void getBindingInfo(const ShaderType* type, uint32* set, uint32* binding, uint32* tableSize, string* tableName);
 
 private:
@@ -45,11 +50,9 @@ private:
 	const ShaderStages stage_;
 	std::stringstream source_;
 	std::vector<const StructType*> generatedStructs_;
+	std::vector<const StructType*> declaredPointers_;
+	std::vector<string> generatedTables_;
 	uint32 uid_;
-	struct {
-		uint32 in;
-		uint32 out;
-	} localIdx_;
 
 	VSL_NO_COPY(StageGenerator)
 	VSL_NO_MOVE(StageGenerator)
@@ -192,7 +192,37 @@ void Functions::Initialize()
 	Builtins_["ldexp"] = {
 		{ "ldexp", GENF, { GENF, GENI } }
 	};
-	// packing and unpacking functions
+	Builtins_["packHalf2x16"] = {
+		{ "packHalf2x16", "uint", { "float2" } }
+	};
+	Builtins_["packSnorm2x16"] = {
+		{ "packSnorm2x16", "uint", { "float2" } }
+	};
+	Builtins_["packSnorm4x8"] = {
+		{ "packSnorm4x8", "uint", { "float4" } }
+	};
+	Builtins_["packUnorm2x16"] = {
+		{ "packUnorm2x16", "uint", { "float2" } }
+	};
+	Builtins_["packUnorm4x8"] = {
+		{ "packUnorm4x8", "uint", { "float4" } }
+	};
+	Builtins_["unpackHalf2x16"] = {
+		{ "unpackHalf2x16", "float2", { "uint" } }
+	};
+	Builtins_["unpackSnorm2x16"] = {
+		{ "unpackSnorm2x16", "float2", { "uint" } }
+	};
+	Builtins_["unpackSnorm4x8"] = {
+		{ "unpackSnorm4x8", "float4", { "uint" } }
+	};
+	Builtins_["unpackUnorm2x16"] = {
+		{ "unpackUnorm2x16", "float2", { "uint" } }
+	};
+	Builtins_["unpackUnorm4x8"] = {
+		{ "unpackUnorm4x8", "float4", { "uint" } }
+	};
+	// packDouble2x32, unpackDouble2x32 (no double types)
 
 	// ===== Vector Functions =====
 	Builtins_["cross"] = {
@@ -236,7 +266,18 @@ void Functions::Initialize()
 		{ "bitCount", GENI, { GENI } },
 		{ "bitCount", GENI, { GENU } },
 	};
-	// bitfieldExtract, bitfieldInsert, bitfieldReverse
+	Builtins_["bitfieldExtract"] = {
+		{ "bitfieldExtract", GENI, { GENI, "int", "int" } },
+		{ "bitfieldExtract", GENU, { GENU, "int", "int" } }
+	};
+	Builtins_["bitfieldInsert"] = {
+		{ "bitfieldInsert", GENI, { GENI, GENI, "int", "int" } },
+		{ "bitfieldInsert", GENU, { GENU, GENU, "int", "int" } }
+	};
+	Builtins_["bitfieldReverse"] = {
+		{ "bitfieldReverse", GENI, { GENI } },
+		{ "bitfieldReverse", GENU, { GENU } }
+	};
 	Builtins_["findLSB"] = {
 		{ "findLSB", GENI, { GENI } },
 		{ "findLSB", GENI, { GENU } },
@@ -292,6 +333,44 @@ void Functions::Initialize()
 		{ "transpose", "float4x4", { "float4x4" } }
 	};
 
+	// ===== Derivative Functions =====
+	Builtins_["dFdx"] = {
+		{ "dFdx", GENF, { GENF } }
+	};
+	Builtins_["dFdxCoarse"] = {
+		{ "dFdxCoarse", GENF, { GENF } }
+	};
+	Builtins_["dFdxFine"] = {
+		{ "dFdxFine", GENF, { GENF } }
+	};
+	Builtins_["dFdy"] = {
+		{ "dFdy", GENF, { GENF } }
+	};
+	Builtins_["dFdyCoarse"] = {
+		{ "dFdyCoarse", GENF, { GENF } }
+	};
+	Builtins_["dFdyFine"] = {
+		{ "dFdyFine", GENF, { GENF } }
+	};
+	Builtins_["fwidth"] = {
+		{ "fwidth", GENF, { GENF } }
+	};
+	Builtins_["fwidthCoarse"] = {
+		{ "fwidthCoarse", GENF, { GENF } }
+	};
+	Builtins_["fwidthFine"] = {
+		{ "fwidthFine", GENF, { GENF } }
+	};
+	StageMasks_["dFdx"] = ShaderStages::Fragment;
+	StageMasks_["dFdxCoarse"] = ShaderStages::Fragment;
+	StageMasks_["dFdxFine"] = ShaderStages::Fragment;
+	StageMasks_["dFdy"] = ShaderStages::Fragment;
+	StageMasks_["dFdyCoarse"] = ShaderStages::Fragment;
+	StageMasks_["dFdyFine"] = ShaderStages::Fragment;
+	StageMasks_["fwidth"] = ShaderStages::Fragment;
+	StageMasks_["fwidthCoarse"] = ShaderStages::Fragment;
+	StageMasks_["fwidthFine"] = ShaderStages::Fragment;
+
 	// ===== Texture/Image Functions =====
 	Builtins_["texelFetch"] = {
 		{ "texelFetch", "float4", { "Sampler1D", "int", "int" } },
@@ -355,6 +434,483 @@ void Functions::Initialize()
 		{ "imageSize", "int2", { "Image1DArray<>" } },
 		{ "imageSize", "int3", { "Image2DArray<>" } }
 	};
+	// Explicit sampling (lod/gradient/offset), gathers, and lod queries
+	Builtins_["sampleLod"] = {
+		{ "textureLod", "float4", { "Sampler1D", "float", "float" } },
+		{ "textureLod", "float4", { "Sampler2D", "float2", "float" } },
+		{ "textureLod", "float4", { "Sampler3D", "float3", "float" } },
+		{ "textureLod", "float4", { "Sampler1DArray", "float2", "float" } },
+		{ "textureLod", "float4", { "Sampler2DArray", "float3", "float" } },
+		{ "textureLod", "float4", { "SamplerCube", "float3", "float" } },
+		{ "textureLod", "int4",   { "ISampler1D", "float", "float" } },
+		{ "textureLod", "int4",   { "ISampler2D", "float2", "float" } },
+		{ "textureLod", "int4",   { "ISampler3D", "float3", "float" } },
+		{ "textureLod", "int4",   { "ISampler1DArray", "float2", "float" } },
+		{ "textureLod", "int4",   { "ISampler2DArray", "float3", "float" } },
+		{ "textureLod", "int4",   { "ISamplerCube", "float3", "float" } },
+		{ "textureLod", "uint4",  { "USampler1D", "float", "float" } },
+		{ "textureLod", "uint4",  { "USampler2D", "float2", "float" } },
+		{ "textureLod", "uint4",  { "USampler3D", "float3", "float" } },
+		{ "textureLod", "uint4",  { "USampler1DArray", "float2", "float" } },
+		{ "textureLod", "uint4",  { "USampler2DArray", "float3", "float" } },
+		{ "textureLod", "uint4",  { "USamplerCube", "float3", "float" } }
+	};
+	Builtins_["sampleGrad"] = {
+		{ "textureGrad", "float4", { "Sampler1D", "float", "float", "float" } },
+		{ "textureGrad", "float4", { "Sampler2D", "float2", "float2", "float2" } },
+		{ "textureGrad", "float4", { "Sampler3D", "float3", "float3", "float3" } },
+		{ "textureGrad", "float4", { "Sampler1DArray", "float2", "float", "float" } },
+		{ "textureGrad", "float4", { "Sampler2DArray", "float3", "float2", "float2" } },
+		{ "textureGrad", "float4", { "SamplerCube", "float3", "float3", "float3" } },
+		{ "textureGrad", "int4",   { "ISampler1D", "float", "float", "float" } },
+		{ "textureGrad", "int4",   { "ISampler2D", "float2", "float2", "float2" } },
+		{ "textureGrad", "int4",   { "ISampler3D", "float3", "float3", "float3" } },
+		{ "textureGrad", "int4",   { "ISampler1DArray", "float2", "float", "float" } },
+		{ "textureGrad", "int4",   { "ISampler2DArray", "float3", "float2", "float2" } },
+		{ "textureGrad", "int4",   { "ISamplerCube", "float3", "float3", "float3" } },
+		{ "textureGrad", "uint4",  { "USampler1D", "float", "float", "float" } },
+		{ "textureGrad", "uint4",  { "USampler2D", "float2", "float2", "float2" } },
+		{ "textureGrad", "uint4",  { "USampler3D", "float3", "float3", "float3" } },
+		{ "textureGrad", "uint4",  { "USampler1DArray", "float2", "float", "float" } },
+		{ "textureGrad", "uint4",  { "USampler2DArray", "float3", "float2", "float2" } },
+		{ "textureGrad", "uint4",  { "USamplerCube", "float3", "float3", "float3" } }
+	};
+	Builtins_["sampleOffset"] = {
+		{ "textureOffset", "float4", { "Sampler1D", "float", "int" } },
+		{ "textureOffset", "float4", { "Sampler2D", "float2", "int2" } },
+		{ "textureOffset", "float4", { "Sampler3D", "float3", "int3" } },
+		{ "textureOffset", "float4", { "Sampler1DArray", "float2", "int" } },
+		{ "textureOffset", "float4", { "Sampler2DArray", "float3", "int2" } },
+		{ "textureOffset", "int4",   { "ISampler1D", "float", "int" } },
+		{ "textureOffset", "int4",   { "ISampler2D", "float2", "int2" } },
+		{ "textureOffset", "int4",   { "ISampler3D", "float3", "int3" } },
+		{ "textureOffset", "int4",   { "ISampler1DArray", "float2", "int" } },
+		{ "textureOffset", "int4",   { "ISampler2DArray", "float3", "int2" } },
+		{ "textureOffset", "uint4",  { "USampler1D", "float", "int" } },
+		{ "textureOffset", "uint4",  { "USampler2D", "float2", "int2" } },
+		{ "textureOffset", "uint4",  { "USampler3D", "float3", "int3" } },
+		{ "textureOffset", "uint4",  { "USampler1DArray", "float2", "int" } },
+		{ "textureOffset", "uint4",  { "USampler2DArray", "float3", "int2" } }
+	};
+	Builtins_["sampleLodOffset"] = {
+		{ "textureLodOffset", "float4", { "Sampler1D", "float", "float", "int" } },
+		{ "textureLodOffset", "float4", { "Sampler2D", "float2", "float", "int2" } },
+		{ "textureLodOffset", "float4", { "Sampler3D", "float3", "float", "int3" } },
+		{ "textureLodOffset", "float4", { "Sampler1DArray", "float2", "float", "int" } },
+		{ "textureLodOffset", "float4", { "Sampler2DArray", "float3", "float", "int2" } },
+		{ "textureLodOffset", "int4",   { "ISampler1D", "float", "float", "int" } },
+		{ "textureLodOffset", "int4",   { "ISampler2D", "float2", "float", "int2" } },
+		{ "textureLodOffset", "int4",   { "ISampler3D", "float3", "float", "int3" } },
+		{ "textureLodOffset", "int4",   { "ISampler1DArray", "float2", "float", "int" } },
+		{ "textureLodOffset", "int4",   { "ISampler2DArray", "float3", "float", "int2" } },
+		{ "textureLodOffset", "uint4",  { "USampler1D", "float", "float", "int" } },
+		{ "textureLodOffset", "uint4",  { "USampler2D", "float2", "float", "int2" } },
+		{ "textureLodOffset", "uint4",  { "USampler3D", "float3", "float", "int3" } },
+		{ "textureLodOffset", "uint4",  { "USampler1DArray", "float2", "float", "int" } },
+		{ "textureLodOffset", "uint4",  { "USampler2DArray", "float3", "float", "int2" } }
+	};
+	Builtins_["sampleGradOffset"] = {
+		{ "textureGradOffset", "float4", { "Sampler1D", "float", "float", "float", "int" } },
+		{ "textureGradOffset", "float4", { "Sampler2D", "float2", "float2", "float2", "int2" } },
+		{ "textureGradOffset", "float4", { "Sampler3D", "float3", "float3", "float3", "int3" } },
+		{ "textureGradOffset", "float4", { "Sampler1DArray", "float2", "float", "float", "int" } },
+		{ "textureGradOffset", "float4", { "Sampler2DArray", "float3", "float2", "float2", "int2" } },
+		{ "textureGradOffset", "int4",   { "ISampler1D", "float", "float", "float", "int" } },
+		{ "textureGradOffset", "int4",   { "ISampler2D", "float2", "float2", "float2", "int2" } },
+		{ "textureGradOffset", "int4",   { "ISampler3D", "float3", "float3", "float3", "int3" } },
+		{ "textureGradOffset", "int4",   { "ISampler1DArray", "float2", "float", "float", "int" } },
+		{ "textureGradOffset", "int4",   { "ISampler2DArray", "float3", "float2", "float2", "int2" } },
+		{ "textureGradOffset", "uint4",  { "USampler1D", "float", "float", "float", "int" } },
+		{ "textureGradOffset", "uint4",  { "USampler2D", "float2", "float2", "float2", "int2" } },
+		{ "textureGradOffset", "uint4",  { "USampler3D", "float3", "float3", "float3", "int3" } },
+		{ "textureGradOffset", "uint4",  { "USampler1DArray", "float2", "float", "float", "int" } },
+		{ "textureGradOffset", "uint4",  { "USampler2DArray", "float3", "float2", "float2", "int2" } }
+	};
+	Builtins_["gather"] = {
+		{ "textureGather", "float4", { "Sampler2D", "float2" } },
+		{ "textureGather", "float4", { "Sampler2D", "float2", "int" } },
+		{ "textureGather", "float4", { "Sampler2DArray", "float3" } },
+		{ "textureGather", "float4", { "Sampler2DArray", "float3", "int" } },
+		{ "textureGather", "float4", { "SamplerCube", "float3" } },
+		{ "textureGather", "float4", { "SamplerCube", "float3", "int" } },
+		{ "textureGather", "int4",   { "ISampler2D", "float2" } },
+		{ "textureGather", "int4",   { "ISampler2D", "float2", "int" } },
+		{ "textureGather", "int4",   { "ISampler2DArray", "float3" } },
+		{ "textureGather", "int4",   { "ISampler2DArray", "float3", "int" } },
+		{ "textureGather", "int4",   { "ISamplerCube", "float3" } },
+		{ "textureGather", "int4",   { "ISamplerCube", "float3", "int" } },
+		{ "textureGather", "uint4",  { "USampler2D", "float2" } },
+		{ "textureGather", "uint4",  { "USampler2D", "float2", "int" } },
+		{ "textureGather", "uint4",  { "USampler2DArray", "float3" } },
+		{ "textureGather", "uint4",  { "USampler2DArray", "float3", "int" } },
+		{ "textureGather", "uint4",  { "USamplerCube", "float3" } },
+		{ "textureGather", "uint4",  { "USamplerCube", "float3", "int" } }
+	};
+	Builtins_["gatherOffset"] = {
+		{ "textureGatherOffset", "float4", { "Sampler2D", "float2", "int2" } },
+		{ "textureGatherOffset", "float4", { "Sampler2D", "float2", "int2", "int" } },
+		{ "textureGatherOffset", "float4", { "Sampler2DArray", "float3", "int2" } },
+		{ "textureGatherOffset", "float4", { "Sampler2DArray", "float3", "int2", "int" } },
+		{ "textureGatherOffset", "int4",   { "ISampler2D", "float2", "int2" } },
+		{ "textureGatherOffset", "int4",   { "ISampler2D", "float2", "int2", "int" } },
+		{ "textureGatherOffset", "int4",   { "ISampler2DArray", "float3", "int2" } },
+		{ "textureGatherOffset", "int4",   { "ISampler2DArray", "float3", "int2", "int" } },
+		{ "textureGatherOffset", "uint4",  { "USampler2D", "float2", "int2" } },
+		{ "textureGatherOffset", "uint4",  { "USampler2D", "float2", "int2", "int" } },
+		{ "textureGatherOffset", "uint4",  { "USampler2DArray", "float3", "int2" } },
+		{ "textureGatherOffset", "uint4",  { "USampler2DArray", "float3", "int2", "int" } }
+	};
+	Builtins_["lodOf"] = {
+		{ "textureQueryLod", "float2", { "Sampler1D", "float" } },
+		{ "textureQueryLod", "float2", { "Sampler2D", "float2" } },
+		{ "textureQueryLod", "float2", { "Sampler3D", "float3" } },
+		{ "textureQueryLod", "float2", { "Sampler1DArray", "float2" } },
+		{ "textureQueryLod", "float2", { "Sampler2DArray", "float3" } },
+		{ "textureQueryLod", "float2", { "SamplerCube", "float3" } },
+		{ "textureQueryLod", "float2", { "ISampler1D", "float" } },
+		{ "textureQueryLod", "float2", { "ISampler2D", "float2" } },
+		{ "textureQueryLod", "float2", { "ISampler3D", "float3" } },
+		{ "textureQueryLod", "float2", { "ISampler1DArray", "float2" } },
+		{ "textureQueryLod", "float2", { "ISampler2DArray", "float3" } },
+		{ "textureQueryLod", "float2", { "ISamplerCube", "float3" } },
+		{ "textureQueryLod", "float2", { "USampler1D", "float" } },
+		{ "textureQueryLod", "float2", { "USampler2D", "float2" } },
+		{ "textureQueryLod", "float2", { "USampler3D", "float3" } },
+		{ "textureQueryLod", "float2", { "USampler1DArray", "float2" } },
+		{ "textureQueryLod", "float2", { "USampler2DArray", "float3" } },
+		{ "textureQueryLod", "float2", { "USamplerCube", "float3" } }
+	};
+	StageMasks_["sampleOffset"] = ShaderStages::Fragment; // Implicit derivatives
+	StageMasks_["lodOf"] = ShaderStages::Fragment;
+
+	// ===== Barrier Functions =====
+	Builtins_["barrier"] = {
+		{ "barrier", "void", { } }
+	};
+	Builtins_["memoryBarrier"] = {
+		{ "memoryBarrier", "void", { } }
+	};
+	Builtins_["memoryBarrierBuffer"] = {
+		{ "memoryBarrierBuffer", "void", { } }
+	};
+	Builtins_["memoryBarrierImage"] = {
+		{ "memoryBarrierImage", "void", { } }
+	};
+	Builtins_["memoryBarrierShared"] = {
+		{ "memoryBarrierShared", "void", { } }
+	};
+	Builtins_["groupMemoryBarrier"] = {
+		{ "groupMemoryBarrier", "void", { } }
+	};
+	StageMasks_["barrier"] = ShaderStages::Compute;
+	StageMasks_["memoryBarrierShared"] = ShaderStages::Compute;
+	StageMasks_["groupMemoryBarrier"] = ShaderStages::Compute;
+
+	// ===== Atomic Functions =====
+	// The first argument is the atomic target, which is validated separately as an lvalue
+	Builtins_["atomicAdd"] = {
+		{ "atomicAdd", "int", { "int", "int" } },
+		{ "atomicAdd", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicMin"] = {
+		{ "atomicMin", "int", { "int", "int" } },
+		{ "atomicMin", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicMax"] = {
+		{ "atomicMax", "int", { "int", "int" } },
+		{ "atomicMax", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicAnd"] = {
+		{ "atomicAnd", "int", { "int", "int" } },
+		{ "atomicAnd", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicOr"] = {
+		{ "atomicOr", "int", { "int", "int" } },
+		{ "atomicOr", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicXor"] = {
+		{ "atomicXor", "int", { "int", "int" } },
+		{ "atomicXor", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicExchange"] = {
+		{ "atomicExchange", "int", { "int", "int" } },
+		{ "atomicExchange", "uint", { "uint", "uint" } }
+	};
+	Builtins_["atomicCompSwap"] = {
+		{ "atomicCompSwap", "int", { "int", "int", "int" } },
+		{ "atomicCompSwap", "uint", { "uint", "uint", "uint" } }
+	};
+
+	// ===== Subgroup Functions =====
+	// Each function is tagged with the subgroup operation class (and extension) that it requires
+	Builtins_["subgroupBarrier"] = {
+		{ "subgroupBarrier", "void", { } }
+	};
+	Builtins_["subgroupMemoryBarrier"] = {
+		{ "subgroupMemoryBarrier", "void", { } }
+	};
+	Builtins_["subgroupMemoryBarrierBuffer"] = {
+		{ "subgroupMemoryBarrierBuffer", "void", { } }
+	};
+	Builtins_["subgroupMemoryBarrierImage"] = {
+		{ "subgroupMemoryBarrierImage", "void", { } }
+	};
+	Builtins_["subgroupMemoryBarrierShared"] = {
+		{ "subgroupMemoryBarrierShared", "void", { } }
+	};
+	Builtins_["subgroupElect"] = {
+		{ "subgroupElect", "bool", { } }
+	};
+	Builtins_["subgroupAll"] = {
+		{ "subgroupAll", "bool", { "bool" } }
+	};
+	Builtins_["subgroupAny"] = {
+		{ "subgroupAny", "bool", { "bool" } }
+	};
+	Builtins_["subgroupAllEqual"] = {
+		{ "subgroupAllEqual", "bool", { GENI } },
+		{ "subgroupAllEqual", "bool", { GENU } },
+		{ "subgroupAllEqual", "bool", { GENF } },
+		{ "subgroupAllEqual", "bool", { GENB } }
+	};
+	Builtins_["subgroupBroadcast"] = {
+		{ "subgroupBroadcast", GENI, { GENI, "uint" } },
+		{ "subgroupBroadcast", GENU, { GENU, "uint" } },
+		{ "subgroupBroadcast", GENF, { GENF, "uint" } },
+		{ "subgroupBroadcast", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupBroadcastFirst"] = {
+		{ "subgroupBroadcastFirst", GENI, { GENI } },
+		{ "subgroupBroadcastFirst", GENU, { GENU } },
+		{ "subgroupBroadcastFirst", GENF, { GENF } },
+		{ "subgroupBroadcastFirst", GENB, { GENB } }
+	};
+	Builtins_["subgroupBallot"] = {
+		{ "subgroupBallot", "uint4", { "bool" } }
+	};
+	Builtins_["subgroupInverseBallot"] = {
+		{ "subgroupInverseBallot", "bool", { "uint4" } }
+	};
+	Builtins_["subgroupBallotBitExtract"] = {
+		{ "subgroupBallotBitExtract", "bool", { "uint4", "uint" } }
+	};
+	Builtins_["subgroupBallotBitCount"] = {
+		{ "subgroupBallotBitCount", "uint", { "uint4" } }
+	};
+	Builtins_["subgroupBallotInclusiveBitCount"] = {
+		{ "subgroupBallotInclusiveBitCount", "uint", { "uint4" } }
+	};
+	Builtins_["subgroupBallotExclusiveBitCount"] = {
+		{ "subgroupBallotExclusiveBitCount", "uint", { "uint4" } }
+	};
+	Builtins_["subgroupBallotFindLSB"] = {
+		{ "subgroupBallotFindLSB", "uint", { "uint4" } }
+	};
+	Builtins_["subgroupBallotFindMSB"] = {
+		{ "subgroupBallotFindMSB", "uint", { "uint4" } }
+	};
+	Builtins_["subgroupShuffle"] = {
+		{ "subgroupShuffle", GENI, { GENI, "uint" } },
+		{ "subgroupShuffle", GENU, { GENU, "uint" } },
+		{ "subgroupShuffle", GENF, { GENF, "uint" } },
+		{ "subgroupShuffle", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupShuffleXor"] = {
+		{ "subgroupShuffleXor", GENI, { GENI, "uint" } },
+		{ "subgroupShuffleXor", GENU, { GENU, "uint" } },
+		{ "subgroupShuffleXor", GENF, { GENF, "uint" } },
+		{ "subgroupShuffleXor", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupShuffleUp"] = {
+		{ "subgroupShuffleUp", GENI, { GENI, "uint" } },
+		{ "subgroupShuffleUp", GENU, { GENU, "uint" } },
+		{ "subgroupShuffleUp", GENF, { GENF, "uint" } },
+		{ "subgroupShuffleUp", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupShuffleDown"] = {
+		{ "subgroupShuffleDown", GENI, { GENI, "uint" } },
+		{ "subgroupShuffleDown", GENU, { GENU, "uint" } },
+		{ "subgroupShuffleDown", GENF, { GENF, "uint" } },
+		{ "subgroupShuffleDown", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupAdd"] = {
+		{ "subgroupAdd", GENI, { GENI } },
+		{ "subgroupAdd", GENU, { GENU } },
+		{ "subgroupAdd", GENF, { GENF } }
+	};
+	Builtins_["subgroupMul"] = {
+		{ "subgroupMul", GENI, { GENI } },
+		{ "subgroupMul", GENU, { GENU } },
+		{ "subgroupMul", GENF, { GENF } }
+	};
+	Builtins_["subgroupMin"] = {
+		{ "subgroupMin", GENI, { GENI } },
+		{ "subgroupMin", GENU, { GENU } },
+		{ "subgroupMin", GENF, { GENF } }
+	};
+	Builtins_["subgroupMax"] = {
+		{ "subgroupMax", GENI, { GENI } },
+		{ "subgroupMax", GENU, { GENU } },
+		{ "subgroupMax", GENF, { GENF } }
+	};
+	Builtins_["subgroupAnd"] = {
+		{ "subgroupAnd", GENI, { GENI } },
+		{ "subgroupAnd", GENU, { GENU } },
+		{ "subgroupAnd", GENB, { GENB } }
+	};
+	Builtins_["subgroupOr"] = {
+		{ "subgroupOr", GENI, { GENI } },
+		{ "subgroupOr", GENU, { GENU } },
+		{ "subgroupOr", GENB, { GENB } }
+	};
+	Builtins_["subgroupXor"] = {
+		{ "subgroupXor", GENI, { GENI } },
+		{ "subgroupXor", GENU, { GENU } },
+		{ "subgroupXor", GENB, { GENB } }
+	};
+	Builtins_["subgroupInclusiveAdd"] = {
+		{ "subgroupInclusiveAdd", GENI, { GENI } },
+		{ "subgroupInclusiveAdd", GENU, { GENU } },
+		{ "subgroupInclusiveAdd", GENF, { GENF } }
+	};
+	Builtins_["subgroupInclusiveMul"] = {
+		{ "subgroupInclusiveMul", GENI, { GENI } },
+		{ "subgroupInclusiveMul", GENU, { GENU } },
+		{ "subgroupInclusiveMul", GENF, { GENF } }
+	};
+	Builtins_["subgroupInclusiveMin"] = {
+		{ "subgroupInclusiveMin", GENI, { GENI } },
+		{ "subgroupInclusiveMin", GENU, { GENU } },
+		{ "subgroupInclusiveMin", GENF, { GENF } }
+	};
+	Builtins_["subgroupInclusiveMax"] = {
+		{ "subgroupInclusiveMax", GENI, { GENI } },
+		{ "subgroupInclusiveMax", GENU, { GENU } },
+		{ "subgroupInclusiveMax", GENF, { GENF } }
+	};
+	Builtins_["subgroupInclusiveAnd"] = {
+		{ "subgroupInclusiveAnd", GENI, { GENI } },
+		{ "subgroupInclusiveAnd", GENU, { GENU } },
+		{ "subgroupInclusiveAnd", GENB, { GENB } }
+	};
+	Builtins_["subgroupInclusiveOr"] = {
+		{ "subgroupInclusiveOr", GENI, { GENI } },
+		{ "subgroupInclusiveOr", GENU, { GENU } },
+		{ "subgroupInclusiveOr", GENB, { GENB } }
+	};
+	Builtins_["subgroupInclusiveXor"] = {
+		{ "subgroupInclusiveXor", GENI, { GENI } },
+		{ "subgroupInclusiveXor", GENU, { GENU } },
+		{ "subgroupInclusiveXor", GENB, { GENB } }
+	};
+	Builtins_["subgroupExclusiveAdd"] = {
+		{ "subgroupExclusiveAdd", GENI, { GENI } },
+		{ "subgroupExclusiveAdd", GENU, { GENU } },
+		{ "subgroupExclusiveAdd", GENF, { GENF } }
+	};
+	Builtins_["subgroupExclusiveMul"] = {
+		{ "subgroupExclusiveMul", GENI, { GENI } },
+		{ "subgroupExclusiveMul", GENU, { GENU } },
+		{ "subgroupExclusiveMul", GENF, { GENF } }
+	};
+	Builtins_["subgroupExclusiveMin"] = {
+		{ "subgroupExclusiveMin", GENI, { GENI } },
+		{ "subgroupExclusiveMin", GENU, { GENU } },
+		{ "subgroupExclusiveMin", GENF, { GENF } }
+	};
+	Builtins_["subgroupExclusiveMax"] = {
+		{ "subgroupExclusiveMax", GENI, { GENI } },
+		{ "subgroupExclusiveMax", GENU, { GENU } },
+		{ "subgroupExclusiveMax", GENF, { GENF } }
+	};
+	Builtins_["subgroupExclusiveAnd"] = {
+		{ "subgroupExclusiveAnd", GENI, { GENI } },
+		{ "subgroupExclusiveAnd", GENU, { GENU } },
+		{ "subgroupExclusiveAnd", GENB, { GENB } }
+	};
+	Builtins_["subgroupExclusiveOr"] = {
+		{ "subgroupExclusiveOr", GENI, { GENI } },
+		{ "subgroupExclusiveOr", GENU, { GENU } },
+		{ "subgroupExclusiveOr", GENB, { GENB } }
+	};
+	Builtins_["subgroupExclusiveXor"] = {
+		{ "subgroupExclusiveXor", GENI, { GENI } },
+		{ "subgroupExclusiveXor", GENU, { GENU } },
+		{ "subgroupExclusiveXor", GENB, { GENB } }
+	};
+	Builtins_["subgroupQuadBroadcast"] = {
+		{ "subgroupQuadBroadcast", GENI, { GENI, "uint" } },
+		{ "subgroupQuadBroadcast", GENU, { GENU, "uint" } },
+		{ "subgroupQuadBroadcast", GENF, { GENF, "uint" } },
+		{ "subgroupQuadBroadcast", GENB, { GENB, "uint" } }
+	};
+	Builtins_["subgroupQuadSwapHorizontal"] = {
+		{ "subgroupQuadSwapHorizontal", GENI, { GENI } },
+		{ "subgroupQuadSwapHorizontal", GENU, { GENU } },
+		{ "subgroupQuadSwapHorizontal", GENF, { GENF } },
+		{ "subgroupQuadSwapHorizontal", GENB, { GENB } }
+	};
+	Builtins_["subgroupQuadSwapVertical"] = {
+		{ "subgroupQuadSwapVertical", GENI, { GENI } },
+		{ "subgroupQuadSwapVertical", GENU, { GENU } },
+		{ "subgroupQuadSwapVertical", GENF, { GENF } },
+		{ "subgroupQuadSwapVertical", GENB, { GENB } }
+	};
+	Builtins_["subgroupQuadSwapDiagonal"] = {
+		{ "subgroupQuadSwapDiagonal", GENI, { GENI } },
+		{ "subgroupQuadSwapDiagonal", GENU, { GENU } },
+		{ "subgroupQuadSwapDiagonal", GENF, { GENF } },
+		{ "subgroupQuadSwapDiagonal", GENB, { GENB } }
+	};
+	SubgroupOps_["subgroupBarrier"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupMemoryBarrier"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupMemoryBarrierBuffer"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupMemoryBarrierImage"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupMemoryBarrierShared"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupElect"] = SubgroupOps::Basic;
+	SubgroupOps_["subgroupAll"] = SubgroupOps::Vote;
+	SubgroupOps_["subgroupAny"] = SubgroupOps::Vote;
+	SubgroupOps_["subgroupAllEqual"] = SubgroupOps::Vote;
+	SubgroupOps_["subgroupBroadcast"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBroadcastFirst"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallot"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupInverseBallot"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotBitExtract"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotBitCount"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotInclusiveBitCount"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotExclusiveBitCount"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotFindLSB"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupBallotFindMSB"] = SubgroupOps::Ballot;
+	SubgroupOps_["subgroupShuffle"] = SubgroupOps::Shuffle;
+	SubgroupOps_["subgroupShuffleXor"] = SubgroupOps::Shuffle;
+	SubgroupOps_["subgroupShuffleUp"] = SubgroupOps::ShuffleRelative;
+	SubgroupOps_["subgroupShuffleDown"] = SubgroupOps::ShuffleRelative;
+	SubgroupOps_["subgroupAdd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupMul"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupMin"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupMax"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupAnd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupOr"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupXor"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveAdd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveMul"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveMin"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveMax"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveAnd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveOr"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupInclusiveXor"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveAdd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveMul"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveMin"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveMax"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveAnd"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveOr"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupExclusiveXor"] = SubgroupOps::Arithmetic;
+	SubgroupOps_["subgroupQuadBroadcast"] = SubgroupOps::Quad;
+	SubgroupOps_["subgroupQuadSwapHorizontal"] = SubgroupOps::Quad;
+	SubgroupOps_["subgroupQuadSwapVertical"] = SubgroupOps::Quad;
+	SubgroupOps_["subgroupQuadSwapDiagonal"] = SubgroupOps::Quad;
+	StageMasks_["subgroupMemoryBarrierShared"] = ShaderStages::Compute;
 }
 
 } // namespace vsl
@@ -17,6 +17,8 @@ namespace vsl
 // ====================================================================================================================
 string Functions::LastError_{ };
 std::unordered_map<string, std::vector<FunctionEntry>> Functions::Builtins_{ };
+std::unordered_map<string, ShaderStages> Functions::StageMasks_{ };
+std::unordered_map<string, SubgroupOps> Functions::SubgroupOps_{ };
 
 
 // ====================================================================================================================
@@ -102,7 +104,13 @@ bool FunctionType::match(const SPtr<Expr> expr) const
 		if (type->isNumericType() || type->isBoolean()) {
 			return etype->hasImplicitCast(type);
 		}
-		else if (type->isSampler() || type->isImage()) {
+		else if (type->isSampler()) { // Rank and sampled type (float/int/uint) must match
+			const auto tfmt = type->texel.format;
+			const auto efmt = etype->texel.format;
+			return (type->baseType == etype->baseType) && (type->texel.rank == etype->texel.rank) &&
+				(tfmt->isSigned() == efmt->isSigned()) && (tfmt->isUnsigned() == efmt->isUnsigned());
+		}
+		else if (type->isImage()) {
 			return (type->baseType == etype->baseType) && (type->texel.rank == etype->texel.rank);
 		}
 		else {
@@ -136,9 +144,8 @@ const ShaderType* FunctionEntry::match(const std::vector<SPtr<Expr>>& params) co
 		if (!ai.match(pi)) {
 			return nullptr;
 		}
-		if (ai.genType) {
-			if (genSize == 0) {
-				genSize = pi->type->numeric.size;
+		if (ai.genType && (pi->type->isNumericType() || pi->type->isBoolean())) {
+			if (genCount == 0) {
 				genCount = pi->type->numeric.dims[0];
 				genType = pi->type->baseType;
 			}
@@ -148,13 +155,49 @@ const ShaderType* FunctionEntry::match(const std::vector<SPtr<Expr>>& params) co
 		}
 	}
 
+	// The gen size is the widest component of the same base type, which matches the GLSL promotion rules
+	for (const auto& pi : params) {
+		if ((genCount != 0) && (pi->type->baseType == genType)) {
+			genSize = std::max(genSize, uint32(pi->type->numeric.size));
+		}
+	}
+
 	// Return the correct type
 	const auto retSize =
 		(!retType.genType || (genSize == 0)) ? retType.type->numeric.size :
 		(retType.type->baseType != genType) ? retType.type->numeric.size : genSize;
-	return retType.genType
-		? TypeList::GetNumericType(retType.type->baseType, retSize, genCount, 1)
-		: retType.type;
+	if (retType.genType) {
+		return TypeList::GetNumericType(retType.type->baseType, retSize, genCount, 1);
+	}
+	if (retType.type->isNumericType() && retType.type->isScalar() && (retType.type->baseType == genType) &&
+			(genSize != 0)) {
+		return TypeList::GetNumericType(genType, genSize, 1, 1); // Reductions (dot, length) keep the gen size
+	}
+	return retType.type;
+}
+
+
+// ====================================================================================================================
+// ====================================================================================================================
+string UserFunction::getDefinition() const
+{
+	const auto retType = entry.retType.type;
+	std::stringstream ss{ std::stringstream::out };
+	ss << retType->getGLSLName() << ' ' << name << '(';
+	for (size_t i = 0; i < params.size(); ++i) {
+		ss << ((i == 0) ? "" : ", ") << params[i].first->getGLSLName() << ' ' << params[i].second;
+	}
+	ss << ")\r\n{\r\n";
+
+	// Inlined bodies assign the result to '_return_', so they need a declaration and final return to be callable
+	if (inlined && !retType->isVoid()) {
+		ss << '\t' << retType->getGLSLName() << " _return_;\r\n" << body << "\treturn _return_;\r\n";
+	}
+	else {
+		ss << body;
+	}
+	ss << "}\r\n";
+	return ss.str();
 }
 
 
@@ -169,6 +212,26 @@ bool Functions::HasFunction(const string& funcName)
 	return (it != Builtins_.end());
 }
 
+// ====================================================================================================================
+ShaderStages Functions::GetStageMask(const string& funcName)
+{
+	if (Builtins_.empty()) {
+		Initialize();
+	}
+	const auto it = StageMasks_.find(funcName);
+	return (it != StageMasks_.end()) ? it->second : ShaderStages::AllStages;
+}
+
+// ====================================================================================================================
+SubgroupOps Functions::GetSubgroupOps(const string& funcName)
+{
+	if (Builtins_.empty()) {
+		Initialize();
+	}
+	const auto it = SubgroupOps_.find(funcName);
+	return (it != SubgroupOps_.end()) ? it->second : SubgroupOps::None;
+}
+
 // ====================================================================================================================
 std::tuple<const ShaderType*, string> Functions::CheckFunction(const string& funcName,
 	const std::vector<SPtr<Expr>>& args)
@@ -8,6 +8,7 @@
 
 #include "../Config.hpp"
 #include "../Types.hpp"
+#include "../ShaderInfo.hpp"
 
 #include <unordered_map>
 #include <vector>
@@ -55,12 +56,38 @@ public:
 }; // class FunctionEntry
 
 
+// Describes a user-defined function, which is matched like a builtin function, and is either emitted as a glsl function
+// or has its body inlined at each call site
+struct UserFunction final
+{
+public:
+	UserFunction(const string& name, bool inlined)
+		: name{ name }, inlined{ inlined }, entry{ }, params{ }, stageMask{ ShaderStages::AllStages }, constants{ }
+		, calls{ }, body{ }
+	{ }
+
+	string getDefinition() const; // The full glsl function definition
+
+public:
+	string name;
+	bool inlined;                                             // If the body is inlined at call sites
+	FunctionEntry entry;                                      // The signature, for matching call arguments
+	std::vector<std::pair<const ShaderType*, string>> params; // The parameter types and names
+	ShaderStages stageMask;                  // The stages the function can be called in (from the builtins it uses)
+	std::vector<string> constants;           // The specialization constants used by the function and its callees
+	std::vector<const UserFunction*> calls;  // The functions called (not inlined) by the function, callees first
+	string body;                             // The generated glsl body statements
+}; // struct UserFunction
+
+
 // Contains the registry of built-in and user defined functions, and constructors
 class Functions final
 {
 public:
 	/* Function Checks */
 	static bool HasFunction(const string& funcName);
+	static ShaderStages GetStageMask(const string& funcName); // The stages that the function can be called in
+	static SubgroupOps GetSubgroupOps(const string& funcName); // The subgroup operations used by the function
 	static std::tuple<const ShaderType*, string> CheckFunction(const string& funcName,
 		const std::vector<SPtr<Expr>>& args);
 	static std::tuple<const ShaderType*, string> CheckConstructor(const string& typeName,
@@ -76,6 +103,8 @@ private:
 private:
 	static string LastError_;
 	static std::unordered_map<string, std::vector<FunctionEntry>> Builtins_;
+	static std::unordered_map<string, ShaderStages> StageMasks_; // Only has entries for stage-restricted functions
+	static std::unordered_map<string, SubgroupOps> SubgroupOps_; // Only has entries for subgroup functions
 }; // class Functions
 
 } // namespace vsl
@@ -0,0 +1,46 @@
+/*
+ * Microsoft Public License (Ms-PL) - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the Microsoft Public License, the text of which can be found in
+ * the 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MS-PL>.
+ */
+
+#include "./Module.hpp"
+
+
+namespace vsl
+{
+
+// ====================================================================================================================
+std::mutex ModuleCache::Mutex_{ };
+std::unordered_map<string, UPtr<ModuleInterface>> ModuleCache::Modules_{ };
+
+// ====================================================================================================================
+const ModuleInterface* ModuleCache::Get(const string& source)
+{
+	std::lock_guard<std::mutex> lock{ Mutex_ };
+
+	const auto it = Modules_.find(source);
+	return (it != Modules_.end()) ? it->second.get() : nullptr;
+}
+
+// ====================================================================================================================
+const ModuleInterface* ModuleCache::Add(const string& source, ModuleInterface&& module)
+{
+	std::lock_guard<std::mutex> lock{ Mutex_ };
+
+	// Keeps the existing interface if another thread added the same source first
+	const auto it = Modules_.emplace(source, nullptr).first;
+	if (!it->second) {
+		it->second = std::make_unique<ModuleInterface>(std::move(module));
+	}
+	return it->second.get();
+}
+
+// ====================================================================================================================
+void ModuleCache::Clear()
+{
+	std::lock_guard<std::mutex> lock{ Mutex_ };
+	Modules_.clear();
+}
+
+} // namespace vsl
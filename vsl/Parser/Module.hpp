@@ -0,0 +1,60 @@
+/*
+ * Microsoft Public License (Ms-PL) - Copyright (c) 2020-2021 Sean Moss
+ * This file is subject to the terms and conditions of the Microsoft Public License, the text of which can be found in
+ * the 'LICENSE' file at the root of this repository, or online at <https://opensource.org/licenses/MS-PL>.
+ */
+
+#pragma once
+
+#include "../Config.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+namespace vsl
+{
+
+// Describes a struct type declared in a module, with member types stored by name so they can be resolved against the
+// type list of each shader that imports the module
+struct ModuleStruct final
+{
+public:
+	struct Member final
+	{
+		string name;
+		string typeName;
+		uint32 arraySize;
+	}; // struct Member
+
+public:
+	string name;
+	std::vector<Member> members;
+}; // struct ModuleStruct
+
+
+// The parsed and type-checked declarations of an imported module file
+struct ModuleInterface final
+{
+public:
+	std::vector<string> imports;       // The import paths, as written in the module
+	std::vector<ModuleStruct> structs; // The declared structs, in declaration order
+}; // struct ModuleInterface
+
+
+// Process-wide cache of module interfaces, keyed on the full module source, so a module shared by many shaders compiled
+// in the same process is only parsed once, and a module whose contents changed is always parsed again
+class ModuleCache final
+{
+public:
+	static const ModuleInterface* Get(const string& source);
+	static const ModuleInterface* Add(const string& source, ModuleInterface&& module);
+	static void Clear(); // Invalidates all previously returned interfaces
+
+private:
+	static std::mutex Mutex_;
+	static std::unordered_map<string, UPtr<ModuleInterface>> Modules_;
+}; // class ModuleCache
+
+} // namespace vsl
@@ -93,9 +93,8 @@ const ShaderType* OpEntry::match(const std::vector<SPtr<Expr>>& params) const
 		if (!ai.match(pi)) {
 			return nullptr;
 		}
-		if (ai.genType) {
-			if (genSize == 0) {
-				genSize = pi->type->numeric.size;
+		if (ai.genType && (pi->type->isNumericType() || pi->type->isBoolean())) {
+			if (genCount == 0) {
 				genCount = pi->type->numeric.dims[0];
 				genType = pi->type->baseType;
 			}
@@ -105,6 +104,13 @@ const ShaderType* OpEntry::match(const std::vector<SPtr<Expr>>& params) const
 		}
 	}
 
+	// The gen size is the widest component of the same base type, which matches the GLSL promotion rules
+	for (const auto& pi : params) {
+		if ((genCount != 0) && (pi->type->baseType == genType)) {
+			genSize = std::max(genSize, uint32(pi->type->numeric.size));
+		}
+	}
+
 	// Return the correct type
 	const auto retSize =
 		(!retType.genType || (genSize == 0)) ? retType.type->numeric.size :
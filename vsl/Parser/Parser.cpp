@@ -9,7 +9,13 @@
 #include "../Grammar/VSLLexer.h"
 #include "./Func.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
 
 
 namespace vsl
@@ -24,6 +30,16 @@ Parser::Parser(Shader* shader, const CompileOptions* options)
 	, scopes_{ }
 	, currentStage_{ ShaderStages::None }
 	, funcGen_{ nullptr }
+	, sourceDir_{ }
+	, module_{ nullptr }
+	, importStack_{ }
+	, imported_{ }
+	, moduleTypes_{ }
+	, moduleScope_{ nullptr }
+	, userFunctions_{ }
+	, userFunc_{ nullptr }
+	, inlineUid_{ 0 }
+	, forceCall_{ false }
 {
 
 }
@@ -35,8 +51,10 @@ Parser::~Parser()
 }
 
 // ====================================================================================================================
-bool Parser::parse(const string& source)
+bool Parser::parse(const string& source, const string& sourceDir)
 {
+	sourceDir_ = sourceDir;
+
 	// Create the lexer and parser objects
 	antlr4::ANTLRInputStream inStream{ source };
 	grammar::VSLLexer lexer{ &inStream };
@@ -97,7 +115,7 @@ void Parser::validateName(const antlr4::Token* name)
 	if (scopes_.hasGlobalName(varName) || scopes_.hasName(varName)) {
 		ERROR(name, mkstr("Duplicate variable name '%s'", varName.c_str()));
 	}
-	if (Functions::HasFunction(varName)) {
+	if (Functions::HasFunction(varName) || getUserFunction(varName)) {
 		ERROR(name, mkstr("Variable name '%s' overlaps with function name", varName.c_str()));
 	}
 	if (shader_->types().getType(varName)) {
@@ -106,7 +124,8 @@ void Parser::validateName(const antlr4::Token* name)
 }
 
 // ====================================================================================================================
-Variable Parser::parseVariableDeclaration(const grammar::VSL::VariableDeclarationContext* ctx, bool global)
+Variable Parser::parseVariableDeclaration(const grammar::VSL::VariableDeclarationContext* ctx, bool global,
+	uint32 maxArraySize)
 {
 	// Perform name validation
 	validateName(ctx->name);
@@ -125,8 +144,8 @@ Variable Parser::parseVariableDeclaration(const grammar::VSL::VariableDeclaratio
 		if (arrSizeLiteral.isNegative() || arrSizeLiteral.isZero()) {
 			ERROR(ctx->arraySize, "Array size cannot be zero or negative");
 		}
-		if (arrSizeLiteral.u > Shader::MAX_ARRAY_SIZE) {
-			ERROR(ctx->arraySize, mkstr("Array is larger than max allowed size %u", Shader::MAX_ARRAY_SIZE));
+		if (arrSizeLiteral.u > maxArraySize) {
+			ERROR(ctx->arraySize, mkstr("Array is larger than max allowed size %u", maxArraySize));
 		}
 		arrSize = uint32(arrSizeLiteral.u);
 	}
@@ -137,6 +156,13 @@ Variable Parser::parseVariableDeclaration(const grammar::VSL::VariableDeclaratio
 			ERROR(ctx->arraySize, "Non-numeric types cannot be arrays");
 		}
 	}
+	if (vType->isBufferPtr()) {
+		shader_->info().flags(shader_->info().flags() | ShaderFlags::BufferReferences);
+	}
+	if (!global && vType->isNumericType() && (vType->numeric.size < 4)) {
+		shader_->info().flags(shader_->info().flags() |
+			((vType->numeric.size == 2) ? ShaderFlags::Arithmetic16 : ShaderFlags::Arithmetic8));
+	}
 
 	// Return
 	return { ctx->name->getText(), VariableType::Unknown, vType, arrSize, Variable::READWRITE };
@@ -154,6 +180,13 @@ Literal Parser::parseLiteral(const antlr4::Token* token)
 		ERROR(token, "Cannot parse empty literal");
 	}
 
+	// Check for the 16-bit suffixes ('hf' for floats, 's' and 'us' for integers)
+	const bool isHex = (txt[0] == '0') && (txt.length() > 1) && (std::tolower(txt[1]) == 'x');
+	const auto lastCh = char(std::tolower(*txt.rbegin()));
+	const auto prevCh = (txt.length() > 1) ? char(std::tolower(txt[txt.length() - 2])) : '\0';
+	const bool isHalf = !isHex && (prevCh == 'h') && (lastCh == 'f');
+	const bool isShort = !isHex && (lastCh == 's');
+
 	// Try parse float first
 	const bool isFlt = (txt.find_first_of(".eE", 0) != string::npos);
 	if (isFlt) {
@@ -167,15 +200,17 @@ Literal Parser::parseLiteral(const antlr4::Token* token)
 		else if (end == beg) {
 			ERROR(token, "Invalid floating point literal");
 		}
+		else if (isHalf && (std::abs(val) > 65504.0)) {
+			ERROR(token, "Half literal is outside representable range");
+		}
 		else {
-			return { val };
+			return { val, isHalf };
 		}
 	}
 
 	// Check integer components
 	const bool isNeg = (txt[0] == '-');
-	const bool isHex = (txt[0] == '0') && (txt.length() > 1) && (std::tolower(txt[1]) == 'x');
-	const bool isU = std::tolower(*txt.rbegin()) == 'u';
+	const bool isU = (lastCh == 'u') || (isShort && (prevCh == 'u'));
 
 	// Parse integers
 	if (isHex || isU) {
@@ -189,8 +224,11 @@ Literal Parser::parseLiteral(const antlr4::Token* token)
 		else if (end == beg) {
 			ERROR(token, "Invalid unsigned integer literal");
 		}
+		else if (isShort && (val > UINT16_MAX)) {
+			ERROR(token, "Unsigned short literal is outside representable range");
+		}
 		else {
-			return { uint64(val) };
+			return { uint64(val), isShort };
 		}
 	}
 	else {
@@ -201,12 +239,222 @@ Literal Parser::parseLiteral(const antlr4::Token* token)
 		else if (end == beg) {
 			ERROR(token, "Invalid signed integer literal");
 		}
+		else if (isShort && ((val < INT16_MIN) || (val > INT16_MAX))) {
+			ERROR(token, "Short literal is outside representable range");
+		}
 		else {
-			return { int64(val) };
+			return { int64(val), isShort };
 		}
 	}
 }
 
+// ====================================================================================================================
+const StructType* Parser::addStructType(const string& typeName, const std::vector<StructType::Member>& members,
+	const antlr4::Token* tk)
+{
+	// Check the name
+	if (shader_->types().getType(typeName)) {
+		ERROR(tk, mkstr("Duplicate type name '%s'", typeName.c_str()));
+	}
+	if (typeName.length() > Shader::MAX_NAME_LENGTH) {
+		ERROR(tk, mkstr("Type names cannot be longer than %u characters", Shader::MAX_NAME_LENGTH));
+	}
+	if (typeName[0] == '_' && *(typeName.rbegin()) == '_') {
+		ERROR(tk, "Type names that start and end with '_' are reserved");
+	}
+
+	// Check the members
+	if (members.size() == 0) {
+		ERROR(tk, "Empty struct types are not allowed");
+	}
+	for (const auto& member : members) {
+		if (member.type->isNumericType() && (member.type->numeric.size < 4)) {
+			shader_->info().flags(shader_->info().flags() |
+				((member.type->numeric.size == 2) ? ShaderFlags::Storage16 : ShaderFlags::Storage8));
+		}
+	}
+	StructType structType{ typeName, members, options_->reorderStructs() };
+	if (structType.size() > Shader::MAX_STRUCT_SIZE) {
+		ERROR(tk, mkstr("Struct types cannot be larger than %u bytes", Shader::MAX_STRUCT_SIZE));
+	}
+
+	// Add the struct type
+	const auto sType = shader_->types().addStructType(typeName, structType);
+	shader_->types().addType(typeName, { sType });
+	return sType;
+}
+
+// ====================================================================================================================
+const UserFunction* Parser::getUserFunction(const string& name) const
+{
+	const auto it = std::find_if(userFunctions_.begin(), userFunctions_.end(), [&name](const UPtr<UserFunction>& func) {
+		return func->name == name;
+	});
+	return (it != userFunctions_.end()) ? it->get() : nullptr;
+}
+
+// ====================================================================================================================
+string Parser::resolveModulePath(const string& baseDir, const string& importPath, const antlr4::Token* tk) const
+{
+	std::error_code ioError{};
+	const auto fullPath = fs::weakly_canonical(fs::path{ baseDir } / importPath, ioError);
+	if (ioError || !fs::is_regular_file(fullPath, ioError)) {
+		ERROR(tk, mkstr("Module file '%s' does not exist", importPath.c_str()));
+	}
+	return fullPath.string();
+}
+
+// ====================================================================================================================
+void Parser::importModule(const string& path, const antlr4::Token* importTk)
+{
+	// Modules are only imported once per shader, but their types are still visible to each importing module
+	if (imported_.count(path)) {
+		if (moduleScope_) {
+			const auto& types = moduleTypes_.at(path);
+			moduleScope_->insert(types.begin(), types.end());
+		}
+		return;
+	}
+	if (std::find(importStack_.begin(), importStack_.end(), path) != importStack_.end()) {
+		ERROR(importTk, mkstr("Cyclic import of module '%s'", path.c_str()));
+	}
+
+	// Load the module source
+	std::ifstream inFile{ path, std::istream::in };
+	if (!inFile) {
+		ERROR(importTk, mkstr("Could not open module file '%s'", path.c_str()));
+	}
+	std::stringstream fileContents{};
+	fileContents << inFile.rdbuf();
+	const auto source = fileContents.str();
+
+	// Use the cached interface, or parse and cache the module (types resolve only against the module and its imports)
+	const auto parentScope = moduleScope_;
+	moduleScope_ = &(moduleTypes_[path] = {});
+	importStack_.push_back(path);
+	if (const auto module = ModuleCache::Get(source); module) {
+		const auto moduleDir = fs::path{ path }.parent_path().string();
+		for (const auto& import : module->imports) {
+			importModule(resolveModulePath(moduleDir, import, importTk), importTk);
+		}
+		for (const auto& mStruct : module->structs) {
+			std::vector<StructType::Member> members{};
+			for (const auto& mMember : mStruct.members) {
+				const auto mType = shader_->types().parseOrGetType(mMember.typeName);
+				if (!mType) {
+					ERROR(importTk, mkstr("In module '%s' - unknown type: %s", path.c_str(),
+						shader_->types().lastError().c_str()));
+				}
+				checkModuleType(mType, mMember.typeName, importTk);
+				if (mType->isBufferPtr()) {
+					shader_->info().flags(shader_->info().flags() | ShaderFlags::BufferReferences);
+				}
+				members.push_back({ mMember.name, mMember.arraySize, mType });
+			}
+			addStructType(mStruct.name, members, importTk);
+			moduleScope_->insert(mStruct.name);
+		}
+	}
+	else {
+		ModuleInterface newModule{};
+		parseModule(path, source, &newModule);
+		ModuleCache::Add(source, std::move(newModule));
+	}
+	importStack_.pop_back();
+	imported_.insert(path);
+
+	// Make the module types visible to the importing module
+	moduleScope_ = parentScope;
+	if (moduleScope_) {
+		const auto& types = moduleTypes_.at(path);
+		moduleScope_->insert(types.begin(), types.end());
+	}
+}
+
+// ====================================================================================================================
+void Parser::checkModuleType(const ShaderType* type, const string& typeName, const antlr4::Token* tk) const
+{
+	// Module structs can only reference structs declared in the module or in its imports
+	if (!moduleScope_ || !type->isBufferPtr()) {
+		return;
+	}
+	const auto& structName = type->buffer.structType->userStruct.type->name();
+	if (!moduleScope_->count(structName)) {
+		ERROR(tk, mkstr("Module type '%s' references struct '%s', which is not declared in the module or its imports",
+			typeName.c_str(), structName.c_str()));
+	}
+}
+
+// ====================================================================================================================
+void Parser::parseModule(const string& path, const string& source, ModuleInterface* module)
+{
+	// Create the lexer and parser objects
+	antlr4::ANTLRInputStream inStream{ source };
+	grammar::VSLLexer lexer{ &inStream };
+	antlr4::CommonTokenStream tokenStream{ &lexer };
+	grammar::VSL parser{ &tokenStream };
+
+	// Install error listener
+	ErrorListener listener{ this };
+	lexer.removeErrorListeners();
+	parser.removeErrorListeners();
+	lexer.addErrorListener(&listener);
+	parser.addErrorListener(&listener);
+
+	// Swap to the module state
+	const auto oldTokens = tokens_;
+	const auto oldDir = sourceDir_;
+	const auto oldModule = module_;
+	tokens_ = &tokenStream;
+	sourceDir_ = fs::path{ path }.parent_path().string();
+	module_ = module;
+
+	// Parse and visit the module, with errors reported relative to the module file
+	try {
+		const auto moduleCtx = parser.moduleFile();
+		if (hasError()) {
+			throw error_;
+		}
+		for (const auto import : moduleCtx->shaderImportStatement()) {
+			visit(import);
+		}
+		for (const auto structDef : moduleCtx->shaderStructDefinition()) {
+			visit(structDef);
+		}
+	}
+	catch (const ShaderError& err) {
+		tokens_ = oldTokens;
+		sourceDir_ = oldDir;
+		module_ = oldModule;
+		ShaderError modErr{ mkstr("In module '%s' - %s", path.c_str(), err.message().c_str()), err.line(),
+			err.character() };
+		modErr.badText(err.badText());
+		throw modErr;
+	}
+
+	// Restore the shader state
+	tokens_ = oldTokens;
+	sourceDir_ = oldDir;
+	module_ = oldModule;
+}
+
+// ====================================================================================================================
+bool Parser::isConstantExpression(antlr4::tree::ParseTree* tree) const
+{
+	// Constant expressions only contain literals, specialization constants, and operators
+	if (const auto name = dynamic_cast<grammar::VSL::NameAtomContext*>(tree); name) {
+		const auto var = scopes_.getVariable(name->IDENTIFIER()->getText());
+		return var && (var->varType == VariableType::Constant);
+	}
+	if (dynamic_cast<grammar::VSL::IndexAtomContext*>(tree) || dynamic_cast<grammar::VSL::MemberAtomContext*>(tree) ||
+			dynamic_cast<grammar::VSL::CallAtomContext*>(tree)) {
+		return false;
+	}
+	return std::all_of(tree->children.begin(), tree->children.end(), [this](antlr4::tree::ParseTree* child) {
+		return isConstantExpression(child);
+	});
+}
+
 // ====================================================================================================================
 void Parser::validateSwizzle(uint32 compCount, antlr4::tree::TerminalNode* swizzle)
 {
@@ -165,6 +165,9 @@ VISIT_FUNC(IndexAtom)
 		if (index2) {
 			ERROR(ctx->index2, "Second indexer not valid for arrays");
 		}
+		if (!index->type->isInteger() || !index->type->isScalar()) {
+			ERROR(ctx->index, "Array indexer must have scalar integer type");
+		}
 		return MAKE_EXPR(mkstr("%s[%s]", leftStr.c_str(), indexStr.c_str()), left->type, 1);
 	}
 	else if (left->type->isScalar()) {
@@ -223,7 +226,8 @@ VISIT_FUNC(IndexAtom)
 
 		const auto loadStr =
 			(left->type->texel.format->count == 1) ? "(imageLoad(%s, %s).x)" :
-			(left->type->texel.format->count == 2) ? "(imageLoad(%s, %s).xy)" : "imageLoad(%s, %s)";
+			(left->type->texel.format->count == 2) ? "(imageLoad(%s, %s).xy)" :
+			(left->type->texel.format->count == 3) ? "(imageLoad(%s, %s).xyz)" : "imageLoad(%s, %s)";
 		return MAKE_EXPR(mkstr(loadStr, leftStr.c_str(), indexStr.c_str()),
 			left->type->texel.format->asDataType(), 1);
 	}
@@ -235,6 +239,14 @@ VISIT_FUNC(IndexAtom)
 		const auto sType = shader_->types().getType(left->type->buffer.structType->userStruct.type->name());
 		return MAKE_EXPR(mkstr("%s[%s]", leftStr.c_str(), indexStr.c_str()), sType, 1);
 	}
+	else if (left->type->isBufferPtr()) {
+		if (!index->type->isInteger() || !index->type->isScalar()) {
+			ERROR(ctx->index, "BufferPtr indexer must have scalar integer type");
+		}
+
+		const auto sType = shader_->types().getType(left->type->buffer.structType->userStruct.type->name());
+		return MAKE_EXPR(mkstr("%s._data_[%s]", leftStr.c_str(), indexStr.c_str()), sType, 1);
+	}
 	else if (left->type->isROTexels()) {
 		if (!index->type->isInteger() || !index->type->isScalar()) {
 			ERROR(ctx->index, "ROTexels indexer must have scalar integer type");
@@ -250,7 +262,8 @@ VISIT_FUNC(IndexAtom)
 
 		const auto loadStr =
 			(left->type->texel.format->count == 1) ? "(imageLoad(%s, %s).x)" :
-			(left->type->texel.format->count == 2) ? "(imageLoad(%s, %s).xy)" : "imageLoad(%s, %s)";
+			(left->type->texel.format->count == 2) ? "(imageLoad(%s, %s).xy)" :
+			(left->type->texel.format->count == 3) ? "(imageLoad(%s, %s).xyz)" : "imageLoad(%s, %s)";
 		return MAKE_EXPR(mkstr(loadStr, leftStr.c_str(), indexStr.c_str()),
 			left->type->texel.format->asDataType(), 1);
 	}
@@ -295,19 +308,59 @@ VISIT_FUNC(MemberAtom)
 // ====================================================================================================================
 VISIT_FUNC(CallAtom)
 {
+	const auto call = VISIT_EXPR(ctx->functionCall());
+	if (call->type->baseType == BaseType::Void) {
+		ERROR(ctx->functionCall()->name, "Functions that do not return a value cannot be used in expressions");
+	}
+	return call;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(FunctionCall)
+{
+	// Atomic functions are handled separately
+	if (ctx->dst) {
+		return visitAtomicCall(ctx);
+	}
+
 	// Visit the argument expressions
 	std::vector<SPtr<Expr>> arguments{};
-	for (const auto arg : ctx->functionCall()->args) {
+	for (const auto arg : ctx->args) {
 		const auto argexpr = VISIT_EXPR(arg);
 		arguments.push_back(argexpr);
 	}
 
-	// Validate the constructor/function
-	const auto fnName = ctx->functionCall()->name->getText();
+	// User functions are handled separately
+	const auto fnName = ctx->name->getText();
+	if (const auto userFunc = getUserFunction(fnName); userFunc) {
+		return visitUserCall(ctx, userFunc, arguments);
+	}
+
+	// Validate the constructor/function (user function stages are limited by the functions they call)
 	const auto [callType, callName] = Functions::CheckFunction(fnName, arguments);
 	if (!callType) {
-		ERROR(ctx->functionCall()->name, Functions::LastError());
+		ERROR(ctx->name, Functions::LastError());
+	}
+	if (((fnName == "subgroupBroadcast") || (fnName == "subgroupQuadBroadcast")) &&
+			!isConstantExpression(ctx->args[1])) {
+		ERROR(ctx->args[1], mkstr("The id argument to '%s' must be a compile-time constant", fnName.c_str()));
 	}
+	if (userFunc_) {
+		userFunc_->stageMask = userFunc_->stageMask & Functions::GetStageMask(fnName);
+		if (!bool(userFunc_->stageMask)) {
+			ERROR(ctx->name, mkstr("Function '%s' is not available in the same stages as the rest of '%s'",
+				fnName.c_str(), userFunc_->name.c_str()));
+		}
+	}
+	else if (!bool(Functions::GetStageMask(fnName) & currentStage_)) {
+		ERROR(ctx->name, mkstr("Function '%s' is not available in the %s stage", fnName.c_str(),
+			ShaderStageToStr(currentStage_).c_str()));
+	}
+	if (callType->isNumericType() && (callType->numeric.size < 4)) {
+		shader_->info().flags(shader_->info().flags() |
+			((callType->numeric.size == 2) ? ShaderFlags::Arithmetic16 : ShaderFlags::Arithmetic8));
+	}
+	shader_->info().subgroupOps(shader_->info().subgroupOps() | Functions::GetSubgroupOps(fnName));
 
 	// Create the call string
 	std::stringstream ss{ std::stringstream::out };
@@ -315,13 +368,160 @@ VISIT_FUNC(CallAtom)
 	for (const auto& arg : arguments) {
 		ss << arg->refString << ", ";
 	}
-	ss.seekp(-2, std::stringstream::cur);
+	if (!arguments.empty()) {
+		ss.seekp(-2, std::stringstream::cur);
+	}
 	ss << " )"; // Overwrite last ", " with function close " )"
 
 	// Emit temp and return
 	return MAKE_EXPR(ss.str(), callType, 1);
 }
 
+// ====================================================================================================================
+antlrcpp::Any Parser::visitAtomicCall(grammar::VSL::FunctionCallContext* ctx)
+{
+	// Visit the target lvalue
+	const auto dst = VISIT_EXPR(ctx->dst);
+	const auto dtype = dst->type;
+	const auto isImage = (dst->refString.find("imageStore") == 0);
+
+	// Find the root variable of the lvalue
+	auto root = ctx->dst;
+	while (!root->name) {
+		root = root->val;
+	}
+	const auto rootVar = scopes_.getVariable(root->name->getText());
+
+	// Validate the target
+	if (isImage) {
+		const auto format = rootVar->dataType->texel.format;
+		if (!format->isIntegerType() || (format->count != 1) || (format->size != 4)) {
+			ERROR(ctx->dst, "Atomic image targets must have a 32-bit scalar integer texel format");
+		}
+	}
+	else if (rootVar->varType == VariableType::Binding) {
+		if (rootVar->dataType->baseType != BaseType::RWBuffer) {
+			ERROR(ctx->dst, "Atomic buffer targets must be members of a RWBuffer");
+		}
+	}
+	else if (rootVar->varType != VariableType::Shared) {
+		ERROR(ctx->dst, "Atomic targets must be RWBuffer members, Image/RWTexels texels, or shared variables");
+	}
+	if (!dtype->isInteger() || !dtype->isScalar() || (dtype->numeric.size != 4) || (dst->arraySize != 1)) {
+		ERROR(ctx->dst, mkstr("Atomic target must be a 32-bit scalar integer, got '%s'", dtype->getVSLName().c_str()));
+	}
+	if (rootVar->varType == VariableType::Binding) {
+		shader_->info().getBinding(rootVar->extra.binding.slot)->readMask |= currentStage_;
+	}
+
+	// Visit the value arguments
+	std::vector<SPtr<Expr>> arguments{ dst };
+	for (const auto arg : ctx->args) {
+		const auto argexpr = VISIT_EXPR(arg);
+		arguments.push_back(argexpr);
+	}
+
+	// Validate the function
+	const auto fnName = ctx->name->getText();
+	const auto [callType, callName] = Functions::CheckFunction(fnName, arguments);
+	if (!callType) {
+		ERROR(ctx->name, Functions::LastError());
+	}
+	if (!callType->isSame(dtype)) {
+		ERROR(ctx->name, mkstr("Atomic arguments must be implicitly castable to target type '%s'",
+			dtype->getVSLName().c_str()));
+	}
+
+	// Create the call string (images insert the values into the imageStore ref string)
+	std::stringstream ss{ std::stringstream::out };
+	for (size_t i = 1; i < arguments.size(); ++i) {
+		ss << ((i == 1) ? "" : ", ") << arguments[i]->refString;
+	}
+	if (isImage) {
+		auto refStr = dst->refString;
+		refStr.replace(refStr.find("{}"), 2, ss.str());
+		refStr = "imageA" + callName.substr(1) + refStr.substr(refStr.find('(')); // atomicX -> imageAtomicX
+		return MAKE_EXPR(refStr, callType, 1);
+	}
+	else {
+		return MAKE_EXPR(mkstr("%s( %s, %s )", callName.c_str(), dst->refString.c_str(), ss.str().c_str()),
+			callType, 1);
+	}
+}
+
+// ====================================================================================================================
+antlrcpp::Any Parser::visitUserCall(grammar::VSL::FunctionCallContext* ctx, const UserFunction* func,
+	const std::vector<SPtr<Expr>>& args)
+{
+	// Validate the arguments
+	const auto callType = func->entry.match(args);
+	if (!callType) {
+		ERROR(ctx->name, mkstr("No overload of function '%s' matched the given arguments", func->name.c_str()));
+	}
+	const auto call = !func->inlined || forceCall_;
+
+	// Track the stages, constants, and called functions
+	if (userFunc_) {
+		userFunc_->stageMask = userFunc_->stageMask & func->stageMask;
+		if (!bool(userFunc_->stageMask)) {
+			ERROR(ctx->name, mkstr("Function '%s' is not available in the same stages as the rest of '%s'",
+				func->name.c_str(), userFunc_->name.c_str()));
+		}
+		auto& constants = userFunc_->constants;
+		for (const auto& cnst : func->constants) {
+			if (std::find(constants.begin(), constants.end(), cnst) == constants.end()) {
+				constants.push_back(cnst);
+			}
+		}
+		auto& calls = userFunc_->calls;
+		for (const auto callee : func->calls) {
+			if (std::find(calls.begin(), calls.end(), callee) == calls.end()) {
+				calls.push_back(callee);
+			}
+		}
+		if (call && (std::find(calls.begin(), calls.end(), func) == calls.end())) {
+			calls.push_back(func);
+		}
+	}
+	else {
+		if (!bool(func->stageMask & currentStage_)) {
+			ERROR(ctx->name, mkstr("Function '%s' is not available in the %s stage", func->name.c_str(),
+				ShaderStageToStr(currentStage_).c_str()));
+		}
+		for (const auto& cnst : func->constants) {
+			shader_->info().getConstant(cnst)->stageMask |= currentStage_;
+		}
+		for (const auto callee : func->calls) {
+			funcGen_->emitFunctionDefinition(callee->name, callee->getDefinition());
+		}
+		if (call) {
+			funcGen_->emitFunctionDefinition(func->name, func->getDefinition());
+		}
+	}
+
+	// Create the call string, or inline the body
+	if (call) {
+		std::stringstream ss{ std::stringstream::out };
+		ss << func->name << "( ";
+		for (const auto& arg : args) {
+			ss << arg->refString << ", ";
+		}
+		if (!args.empty()) {
+			ss.seekp(-2, std::stringstream::cur);
+		}
+		ss << " )"; // Overwrite last ", " with function close " )"
+		return MAKE_EXPR(ss.str(), callType, 1);
+	}
+	else {
+		std::vector<string> argStrs{};
+		for (const auto& arg : args) {
+			argStrs.push_back(arg->refString);
+		}
+		const auto result = funcGen_->emitInlineCall(inlineUid_++, callType, func->params, argStrs, func->body);
+		return MAKE_EXPR(result, callType, 1);
+	}
+}
+
 // ====================================================================================================================
 VISIT_FUNC(LiteralAtom)
 {
@@ -329,13 +529,23 @@ VISIT_FUNC(LiteralAtom)
 
 	if (litptr->INTEGER_LITERAL()) {
 		const auto literal = parseLiteral(litptr->INTEGER_LITERAL()->getSymbol());
-		const auto valstr = (literal.type == Literal::Unsigned) ? mkstr("%llu", literal.u) : mkstr("%lld", literal.i);
-		const auto type = shader_->types().getType((literal.type == Literal::Unsigned) ? "uint" : "int");
+		const auto isU = (literal.type == Literal::Unsigned);
+		if (literal.is16) {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::Arithmetic16);
+			const auto valstr = isU ? mkstr("%lluus", literal.u) : mkstr("%llds", literal.i);
+			return MAKE_EXPR(valstr, shader_->types().getType(isU ? "ushort" : "short"), 1);
+		}
+		const auto valstr = isU ? mkstr("%llu", literal.u) : mkstr("%lld", literal.i);
+		const auto type = shader_->types().getType(isU ? "uint" : "int");
 
 		return MAKE_EXPR(valstr, type, 1);
 	}
 	else if (litptr->FLOAT_LITERAL()) {
-		const auto literal = parseLiteral(litptr->INTEGER_LITERAL()->getSymbol());
+		const auto literal = parseLiteral(litptr->FLOAT_LITERAL()->getSymbol());
+		if (literal.is16) {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::Arithmetic16);
+			return MAKE_EXPR(mkstr("%fhf", literal.f), shader_->types().getType("half"), 1);
+		}
 		return MAKE_EXPR(mkstr("%f", literal.f), shader_->types().getType("float"), 1);
 	}
 	else { // litptr->BOOLEAN_LITERAL()
@@ -363,8 +573,37 @@ VISIT_FUNC(NameAtom)
 	uint32 arraySize{ 1 };
 	if (var->dataType->isNumericType() || var->dataType->isBoolean() || var->dataType->isStruct()) {
 		type = var->dataType;
-		refStr = var->name;
+		refStr = (var->varType == VariableType::Builtin) ? NameGeneration::GetGLSLBuiltinName(var->name) : var->name;
 		arraySize = var->arraySize;
+
+		// Push constants are members of the push constant block
+		if (var->varType == VariableType::Push) {
+			shader_->info().pushConstant().stageMask |= currentStage_;
+			refStr = "_bidx_." + var->name;
+		}
+
+		// Constants are only emitted in the stages that use them (tracked at the call site for user functions)
+		if (var->varType == VariableType::Constant) {
+			shader_->info().getConstant(var->name)->stageMask |= currentStage_;
+			if (userFunc_ && (std::find(userFunc_->constants.begin(), userFunc_->constants.end(), var->name) ==
+					userFunc_->constants.end())) {
+				userFunc_->constants.push_back(var->name);
+			}
+		}
+
+		// Track builtin reads that affect pipeline state
+		if (var->name == "$FragCoord") {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::FragmentCoordRead);
+		}
+		if (var->name == "$ShadingRate") {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::ShadingRateRead);
+		}
+		if (var->name == "$ViewIndex") {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::Multiview);
+		}
+		if (var->name.find("$Subgroup") == 0) {
+			shader_->info().subgroupOps(shader_->info().subgroupOps() | SubgroupOps::Basic);
+		}
 	}
 	else if (var->dataType->isSampler() || var->dataType->isImage() || var->dataType->isROTexels() 
 			|| var->dataType->isRWTexels()) {
@@ -375,7 +614,9 @@ VISIT_FUNC(NameAtom)
 
 		// Update binding
 		funcGen_->emitBindingIndex(var->extra.binding.slot);
-		shader_->info().getBinding(var->extra.binding.slot)->stageMask |= currentStage_;
+		const auto binding = shader_->info().getBinding(var->extra.binding.slot);
+		binding->stageMask |= currentStage_;
+		binding->readMask |= currentStage_;
 	}
 	else if (var->dataType->isROBuffer() || var->dataType->isRWBuffer()) {
 		// Get type/refstr
@@ -384,7 +625,9 @@ VISIT_FUNC(NameAtom)
 
 		// Update binding
 		funcGen_->emitBindingIndex(var->extra.binding.slot);
-		shader_->info().getBinding(var->extra.binding.slot)->stageMask |= currentStage_;
+		const auto binding = shader_->info().getBinding(var->extra.binding.slot);
+		binding->stageMask |= currentStage_;
+		binding->readMask |= currentStage_;
 	}
 	else if (var->dataType->isSPInput()) {
 		if (currentStage_ != ShaderStages::Fragment) {
@@ -393,10 +636,14 @@ VISIT_FUNC(NameAtom)
 		type = var->dataType->texel.format->asDataType();
 		refStr = mkstr("subpassLoad(%s)", var->name.c_str());
 	}
+	else if (var->dataType->isBufferPtr()) {
+		type = var->dataType;
+		refStr = var->name;
+	}
 	else { // Uniform
 		shader_->info().uniform().stageMask |= currentStage_;
 		type = var->dataType->buffer.structType;
-		refStr = var->name;
+		refStr = shader_->info().hasFlag(ShaderFlags::UniformPushConstant) ? ("_bidx_." + var->name) : var->name;
 	}
 
 	// For locals, one more name translation
@@ -6,12 +6,28 @@
 
 #include "./Parser.hpp"
 
+#include <cstring>
+#include <filesystem>
+
 #define VISIT_FUNC(type) antlrcpp::Any Parser::visit##type(grammar::VSL::type##Context* ctx)
 
+namespace fs = std::filesystem;
+
 
 namespace vsl
 {
 
+// ====================================================================================================================
+// GLSL identifiers that user functions cannot redefine (keywords and builtins that VSL emits but does not expose)
+static const std::unordered_set<string> GLSL_RESERVED_NAMES{
+	"main", "texture", "texelFetch", "imageLoad", "imageStore", "subpassLoad", "imageAtomicAdd", "imageAtomicMin",
+	"imageAtomicMax", "imageAtomicAnd", "imageAtomicOr", "imageAtomicXor", "imageAtomicExchange",
+	"imageAtomicCompSwap", "attribute", "const", "uniform", "buffer", "shared", "coherent", "volatile", "restrict",
+	"readonly", "writeonly", "layout", "centroid", "flat", "smooth", "noperspective", "patch", "sample", "invariant",
+	"precise", "break", "continue", "do", "for", "while", "switch", "case", "default", "if", "else", "subroutine",
+	"in", "out", "inout", "true", "false", "discard", "return", "struct", "lowp", "mediump", "highp", "precision"
+};
+
 // ====================================================================================================================
 VISIT_FUNC(File)
 {
@@ -32,10 +48,10 @@ VISIT_FUNC(ShaderTypeStatement)
 	// Validate the shader type
 	const auto shaderType = ctx->type->getText();
 	if (shaderType == "graphics") {
-		return nullptr; // Only graphics supported for now
+		shader_->info().kind(ShaderKind::Graphics);
 	}
 	else if (shaderType == "compute") {
-		ERROR(ctx->type, "Compute shaders are not yet supported");
+		shader_->info().kind(ShaderKind::Compute);
 	}
 	else if (shaderType == "ray") {
 		ERROR(ctx->type, "Ray shaders are not yet supported");
@@ -48,27 +64,42 @@ VISIT_FUNC(ShaderTypeStatement)
 }
 
 // ====================================================================================================================
-VISIT_FUNC(ShaderStructDefinition)
+VISIT_FUNC(ShaderImportStatement)
 {
 	// Check parse status
 	if (bool(shader_->info().stageMask())) {
-		ERROR(ctx, "All user-defined types must be provided before the first stage function");
+		ERROR(ctx, "All imports must be provided before the first stage function");
 	}
 
-	// Get type name and check
-	const auto typeName = ctx->name->getText();
-	if (shader_->types().getType(typeName)) {
-		ERROR(ctx->name, mkstr("Duplicate type name '%s'", typeName.c_str()));
+	// Resolve the path relative to the importing file
+	const auto pathText = ctx->path->getText();
+	const auto importPath = pathText.substr(1, pathText.length() - 2);
+	if (importPath.empty()) {
+		ERROR(ctx->path, "Import path cannot be empty");
 	}
-	if (typeName.length() > Shader::MAX_NAME_LENGTH) {
-		ERROR(ctx->name, mkstr("Type names cannot be longer than %u characters", Shader::MAX_NAME_LENGTH));
+	const auto fullPath = resolveModulePath(sourceDir_, importPath, ctx->path);
+
+	// Record the import, then import
+	if (module_) {
+		module_->imports.push_back(importPath);
 	}
-	if (typeName[0] == '_' && *(typeName.rbegin()) == '_') {
-		ERROR(ctx->name, "Type names that start and end with '_' are reserved");
+	importModule(fullPath, ctx->path);
+
+	return nullptr;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(ShaderStructDefinition)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "All user-defined types must be provided before the first stage function");
 	}
 
 	// Parse the field declarations
+	const auto typeName = ctx->name->getText();
 	std::vector<StructType::Member> members{};
+	ModuleStruct mStruct{ typeName, {} };
 	std::vector<string> names{};
 	for (const auto field : ctx->variableDeclaration()) {
 		// Create variable
@@ -80,8 +111,8 @@ VISIT_FUNC(ShaderStructDefinition)
 		}
 
 		// Check field type
-		if (!fVar.dataType->isNumericType() && !fVar.dataType->isBoolean()) {
-			ERROR(field->baseType, mkstr("Struct field '%s' must be numeric", fVar.name.c_str()));
+		if (!fVar.dataType->isNumericType() && !fVar.dataType->isBoolean() && !fVar.dataType->isBufferPtr()) {
+			ERROR(field->baseType, mkstr("Struct field '%s' must be numeric or a BufferPtr", fVar.name.c_str()));
 		}
 
 		// Add the member
@@ -91,18 +122,18 @@ VISIT_FUNC(ShaderStructDefinition)
 		member.type = fVar.dataType;
 		members.push_back(member);
 		names.push_back(fVar.name);
-	}
-	if (members.size() == 0) {
-		ERROR(ctx->name, "Empty struct types are not allowed");
-	}
-	StructType structType{ typeName, members };
-	if (structType.size() > Shader::MAX_STRUCT_SIZE) {
-		ERROR(ctx->name, mkstr("Struct types cannot be larger than %u bytes", Shader::MAX_STRUCT_SIZE));
+		const auto fTypeName =
+			field->baseType->getText() + (field->subType ? '<' + field->subType->getText() + '>' : "");
+		checkModuleType(fVar.dataType, fTypeName, field->baseType);
+		mStruct.members.push_back({ fVar.name, fTypeName, fVar.arraySize });
 	}
 
-	// Add the struct type
-	const auto sType = shader_->types().addStructType(typeName, structType);
-	shader_->types().addType(typeName, { sType });
+	// Add the struct type (and record it if parsing a module)
+	addStructType(typeName, members, ctx->name);
+	if (module_) {
+		module_->structs.push_back(mStruct);
+		moduleScope_->insert(typeName);
+	}
 
 	return nullptr;
 }
@@ -114,6 +145,9 @@ VISIT_FUNC(ShaderInputOutputStatement)
 	if (bool(shader_->info().stageMask())) {
 		ERROR(ctx, "All interface variables must be provided before the first stage function");
 	}
+	if (shader_->info().isCompute()) {
+		ERROR(ctx, "Compute shaders cannot declare vertex inputs or fragment outputs");
+	}
 
 	// Get direction and interface index
 	const bool isIn = ctx->io->getText() == "in";
@@ -148,6 +182,12 @@ VISIT_FUNC(ShaderInputOutputStatement)
 	// Parse decl
 	const auto varDecl = ctx->variableDeclaration();
 	auto ioVar = parseVariableDeclaration(varDecl, true);
+	if (!ioVar.dataType->isNumericType()) {
+		ERROR(varDecl->baseType, "Vertex inputs and fragment outputs must be numeric types");
+	}
+	if (ioVar.dataType->numeric.size != 4) {
+		ERROR(varDecl->baseType, "Vertex inputs and fragment outputs must be 32-bit types");
+	}
 
 	// Input/Output specific type validation
 	if (isIn) {
@@ -170,10 +210,16 @@ VISIT_FUNC(ShaderInputOutputStatement)
 		if (ioVar.dataType->numeric.dims[0] == 3) {
 			ERROR(varDecl->baseType, "Fragment outputs cannot be 3-component vectors");
 		}
+		if (!ctx->attrs.empty()) {
+			ERROR(ctx->attrs[0], "Fragment outputs cannot have format or rate attributes");
+		}
 	}
 
 	// Add to shader info
 	InterfaceVariable infovar{ varDecl->name->getText(), index, ioVar.dataType, ioVar.arraySize };
+	if (isIn) {
+		parseVertexAttributes(ctx, &infovar);
+	}
 	if (isIn) {
 		shader_->info().inputs().push_back(infovar);
 	}
@@ -185,6 +231,50 @@ VISIT_FUNC(ShaderInputOutputStatement)
 	return nullptr;
 }
 
+// ====================================================================================================================
+void Parser::parseVertexAttributes(const grammar::VSL::ShaderInputOutputStatementContext* ctx, InterfaceVariable* var)
+{
+	bool hasRate{ false };
+	for (const auto attr : ctx->attrs) {
+		const auto attrText = attr->getText();
+
+		// Input rate
+		if ((attrText == "vertex") || (attrText == "instance")) {
+			if (hasRate) {
+				ERROR(attr, "Vertex input rate specified more than once");
+			}
+			hasRate = true;
+			var->perInstance = (attrText == "instance");
+			continue;
+		}
+
+		// Storage format
+		if (var->format) {
+			ERROR(attr, "Vertex input format specified more than once");
+		}
+		const auto format = TypeList::GetTexelFormat(attrText);
+		if (!format) {
+			ERROR(attr, mkstr("Unknown vertex input attribute '%s' (must be a texel format, 'vertex', or 'instance')",
+				attrText.c_str()));
+		}
+
+		// Validate the format against the declared type
+		const auto type = var->type;
+		if (type->isMatrix()) {
+			ERROR(attr, "Matrix vertex inputs cannot have a storage format");
+		}
+		if (format->asDataType()->baseType != type->baseType) {
+			ERROR(attr, mkstr("Vertex format '%s' is not compatible with type '%s'", attrText.c_str(),
+				type->getVSLName().c_str()));
+		}
+		if (format->count < type->numeric.dims[0]) {
+			ERROR(attr, mkstr("Vertex format '%s' has fewer components than type '%s'", attrText.c_str(),
+				type->getVSLName().c_str()));
+		}
+		var->format = format;
+	}
+}
+
 // ====================================================================================================================
 VISIT_FUNC(ShaderUniformStatement)
 {
@@ -218,6 +308,39 @@ VISIT_FUNC(ShaderUniformStatement)
 	return nullptr;
 }
 
+// ====================================================================================================================
+VISIT_FUNC(ShaderPushStatement)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "Push constants must be provided before the first stage function");
+	}
+	if (shader_->info().hasPushConstant()) {
+		ERROR(ctx, "A shader can only have one push constant declaration");
+	}
+
+	// Parse the variable declaration
+	const auto varDecl = ctx->variableDeclaration();
+	const auto pVar = parseVariableDeclaration(varDecl, true);
+	if (!pVar.dataType->isStruct()) {
+		ERROR(varDecl->baseType, "Push constants must be structs");
+	}
+	if (pVar.arraySize != 1) {
+		ERROR(varDecl->arraySize, "Push constants cannot be arrays");
+	}
+	const auto pSize = pVar.dataType->userStruct.type->size();
+	if (pSize > options_->pushConstantSize()) {
+		ERROR(varDecl->baseType, mkstr("Push constant struct (%u bytes) is larger than the push constant budget "
+			"(%u bytes)", pSize, options_->pushConstantSize()));
+	}
+
+	// Add to the shader info and scope
+	shader_->info().pushConstant({ pVar.name, pVar.dataType, 0 });
+	scopes_.addGlobal({ pVar.name, VariableType::Push, pVar.dataType, 1, Variable::READONLY });
+
+	return nullptr;
+}
+
 // ====================================================================================================================
 VISIT_FUNC(ShaderBindingStatement)
 {
@@ -237,6 +360,9 @@ VISIT_FUNC(ShaderBindingStatement)
 	if (bVar.dataType->isNumericType() || bVar.dataType->isBoolean() || bVar.dataType->isStruct()) {
 		ERROR(varDecl->baseType, "Bindings cannot be numeric, boolean, or struct types");
 	}
+	if (bVar.dataType->isBufferPtr()) {
+		ERROR(varDecl->baseType, "Bindings cannot be BufferPtr types (use a uniform or push constant member)");
+	}
 	if (bVar.arraySize != 1) {
 		ERROR(varDecl->arraySize, "Bindings cannot be arrays");
 	}
@@ -275,6 +401,9 @@ VISIT_FUNC(ShaderLocalStatement)
 	if (bool(shader_->info().stageMask())) {
 		ERROR(ctx, "All locals must be provided before the first stage function");
 	}
+	if (shader_->info().isCompute()) {
+		ERROR(ctx, "Compute shaders cannot declare shader locals");
+	}
 
 	// Parse and validate variable
 	const auto isFlat = !!ctx->KW_FLAT();
@@ -286,6 +415,9 @@ VISIT_FUNC(ShaderLocalStatement)
 	if (!lVar.dataType->isNumericType() || lVar.dataType->isMatrix()) {
 		ERROR(varDecl->baseType, "Shader locals must be numeric scalars or vectors");
 	}
+	if (lVar.dataType->numeric.size != 4) {
+		ERROR(varDecl->baseType, "Shader locals must be 32-bit types");
+	}
 	if (lVar.dataType->isInteger() && !isFlat) {
 		ERROR(varDecl->baseType, "Shader locals with integer types must be declared as 'flat'");
 	}
@@ -319,6 +451,9 @@ VISIT_FUNC(ShaderSubpassInputStatement)
 	if (bool(shader_->info().stageMask())) {
 		ERROR(ctx, "All subpass inputs must be provided before the first stage function");
 	}
+	if (shader_->info().isCompute()) {
+		ERROR(ctx, "Compute shaders cannot declare subpass inputs");
+	}
 
 	// Parse and validate format
 	const auto fmtText = ctx->format->getText();
@@ -326,7 +461,7 @@ VISIT_FUNC(ShaderSubpassInputStatement)
 	if (!format) {
 		ERROR(ctx->format, mkstr("No texel format '%s' found", fmtText.c_str()));
 	}
-	if (format->isNormlizedType() || (format->count != 4) || (format->size != 4)) {
+	if (format->isNormlizedType() || format->isPacked() || (format->count != 4) || (format->size != 4)) {
 		ERROR(ctx->format, "Only int4, uint4, and float4 allowed for subpass inputs");
 	}
 
@@ -366,6 +501,304 @@ VISIT_FUNC(ShaderSubpassInputStatement)
 	return nullptr;
 }
 
+// ====================================================================================================================
+VISIT_FUNC(ShaderDepthStatement)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "Depth mode must be provided before the first stage function");
+	}
+	if (shader_->info().depthMode() != DepthMode::None) {
+		ERROR(ctx, "A shader can only have one depth mode declaration");
+	}
+	if (shader_->info().isCompute()) {
+		ERROR(ctx, "Compute shaders cannot declare a depth mode");
+	}
+
+	// Parse and validate mode
+	const auto modeText = ctx->mode->getText();
+	const auto mode = StrToDepthMode(modeText);
+	if (mode == DepthMode::None) {
+		ERROR(ctx->mode, mkstr("Unknown depth mode '%s' (must be any, greater, less, or unchanged)", 
+			modeText.c_str()));
+	}
+
+	// Set mode
+	shader_->info().depthMode(mode);
+
+	return nullptr;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(ShaderWorkgroupStatement)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "Workgroup size must be provided before the first stage function");
+	}
+	if (!shader_->info().isCompute()) {
+		ERROR(ctx, "Workgroup size can only be declared in compute shaders");
+	}
+	if (shader_->info().hasWorkgroupSize()) {
+		ERROR(ctx, "A shader can only have one workgroup size declaration");
+	}
+
+	// Parse and validate the sizes (missing dimensions are 1, constants are validated with their default value)
+	uint32 size[3]{ 1, 1, 1 };
+	uint32 ids[3]{ UINT32_MAX, UINT32_MAX, UINT32_MAX };
+	grammar::VSL::WorkgroupSizeContext* const sizes[3]{ ctx->sizeX, ctx->sizeY, ctx->sizeZ };
+	for (uint32 i = 0; i < 3; ++i) {
+		if (!sizes[i]) {
+			continue;
+		}
+		if (sizes[i]->IDENTIFIER()) {
+			const auto cnst = shader_->info().getConstant(sizes[i]->IDENTIFIER()->getText());
+			if (!cnst) {
+				ERROR(sizes[i], mkstr("No constant with name '%s' found", sizes[i]->IDENTIFIER()->getText().c_str()));
+			}
+			if (!cnst->type->isInteger()) {
+				ERROR(sizes[i], "Workgroup size constants must be integer types");
+			}
+			if (cnst->type->isSigned() && (int32(cnst->value) <= 0)) {
+				ERROR(sizes[i], "Workgroup size cannot be zero or negative");
+			}
+			size[i] = cnst->value;
+			ids[i] = cnst->id;
+		}
+		else {
+			const auto literal = parseLiteral(sizes[i]->INTEGER_LITERAL()->getSymbol());
+			if (literal.isNegative()) {
+				ERROR(sizes[i], "Workgroup size cannot be zero or negative");
+			}
+			size[i] = uint32(std::min<uint64>(literal.u, UINT32_MAX));
+		}
+		if (size[i] == 0) {
+			ERROR(sizes[i], "Workgroup size cannot be zero or negative");
+		}
+		if (size[i] > Shader::MAX_WORKGROUP_SIZE[i]) {
+			ERROR(sizes[i], mkstr("Workgroup size is larger than the max allowed size %u",
+				Shader::MAX_WORKGROUP_SIZE[i]));
+		}
+	}
+	if ((size[0] * size[1] * size[2]) > Shader::MAX_WORKGROUP_INVOCATIONS) {
+		ERROR(ctx, mkstr("Workgroup has more than the max allowed %u invocations", 
+			Shader::MAX_WORKGROUP_INVOCATIONS));
+	}
+
+	// Set size
+	shader_->info().workgroupSize(size[0], size[1], size[2]);
+	shader_->info().workgroupSizeIds(ids[0], ids[1], ids[2]);
+
+	return nullptr;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(ShaderSharedStatement)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "All shared variables must be provided before the first stage function");
+	}
+	if (!shader_->info().isCompute()) {
+		ERROR(ctx, "Shared variables can only be declared in compute shaders");
+	}
+
+	// Parse and validate variable (shared arrays can be much larger than normal arrays)
+	const auto varDecl = ctx->variableDeclaration();
+	const auto sVar = parseVariableDeclaration(varDecl, true, Shader::MAX_SHARED_ARRAY_SIZE);
+	if (!sVar.dataType->isNumericType() && !sVar.dataType->isBoolean()) {
+		ERROR(varDecl->baseType, "Shared variables must be numeric or boolean types");
+	}
+	if (sVar.dataType->isNumericType() && (sVar.dataType->numeric.size != 4)) {
+		ERROR(varDecl->baseType, "Shared variables must be 32-bit types");
+	}
+
+	// Add to info and check size
+	auto& info = shader_->info();
+	info.sharedVariables().push_back({ sVar.name, sVar.dataType, sVar.arraySize });
+	if (info.getSharedSize() > Shader::MAX_SHARED_SIZE) {
+		ERROR(ctx, mkstr("Shared variables are larger than the max allowed size %u bytes", Shader::MAX_SHARED_SIZE));
+	}
+
+	// Add variable
+	scopes_.addGlobal({ sVar.name, VariableType::Shared, sVar.dataType, sVar.arraySize, Variable::READWRITE });
+
+	return nullptr;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(ShaderConstantStatement)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "All constants must be provided before the first stage function");
+	}
+
+	// Parse and validate the id
+	auto& info = shader_->info();
+	const auto idLiteral = parseLiteral(ctx->id);
+	if (idLiteral.isNegative() || (idLiteral.u >= Shader::MAX_CONSTANTS)) {
+		ERROR(ctx->id, mkstr("Constant id must be in the range [0, %u]", Shader::MAX_CONSTANTS - 1));
+	}
+	const auto id = uint32(idLiteral.u);
+	if (const auto dup = info.getConstant(id); dup) {
+		ERROR(ctx->id, mkstr("Constant id %u is already used by '%s'", id, dup->name.c_str()));
+	}
+
+	// Parse and validate variable
+	const auto varDecl = ctx->variableDeclaration();
+	const auto cVar = parseVariableDeclaration(varDecl, true);
+	const auto ctype = cVar.dataType;
+	if (cVar.arraySize != 1) {
+		ERROR(varDecl->arraySize, "Constants cannot be arrays");
+	}
+	if (!(ctype->isNumericType() || ctype->isBoolean()) || !ctype->isScalar()) {
+		ERROR(varDecl->baseType, "Constants must be numeric or boolean scalars");
+	}
+	if (ctype->isNumericType() && (ctype->numeric.size != 4)) {
+		ERROR(varDecl->baseType, "Constants must be 32-bit types");
+	}
+
+	// Parse the default value into the raw bits for the type
+	const auto valCtx = ctx->value;
+	uint32 value{ 0 };
+	if (ctype->isBoolean()) {
+		if (!valCtx->BOOLEAN_LITERAL()) {
+			ERROR(valCtx, "Boolean constants must have a boolean default value");
+		}
+		value = (valCtx->BOOLEAN_LITERAL()->getText() == "true") ? 1 : 0;
+	}
+	else if (valCtx->BOOLEAN_LITERAL()) {
+		ERROR(valCtx, "Numeric constants cannot have a boolean default value");
+	}
+	else {
+		const auto literal = parseLiteral(valCtx->getStart());
+		if (ctype->isFloat()) {
+			const auto fval = float(
+				(literal.type == Literal::Float) ? literal.f :
+				(literal.type == Literal::Signed) ? double(literal.i) : double(literal.u));
+			std::memcpy(&value, &fval, sizeof(float));
+		}
+		else if (literal.type == Literal::Float) {
+			ERROR(valCtx, "Integer constants cannot have a floating point default value");
+		}
+		else if (ctype->isSigned()) {
+			const auto ival = (literal.type == Literal::Signed) ? literal.i : int64(literal.u);
+			if ((ival < INT32_MIN) || (ival > INT32_MAX)) {
+				ERROR(valCtx, "Default value is out of range for type 'int'");
+			}
+			value = uint32(int32(ival));
+		}
+		else {
+			if (literal.isNegative() || (literal.u > UINT32_MAX)) {
+				ERROR(valCtx, "Default value is out of range for type 'uint'");
+			}
+			value = uint32(literal.u);
+		}
+	}
+
+	// Add to info and variable
+	info.constants().push_back({ cVar.name, id, ctype, value });
+	scopes_.addGlobal({ cVar.name, VariableType::Constant, ctype, 1, Variable::READONLY });
+
+	return nullptr;
+}
+
+// ====================================================================================================================
+VISIT_FUNC(ShaderUserFunction)
+{
+	// Check parse status
+	if (bool(shader_->info().stageMask())) {
+		ERROR(ctx, "All user functions must be provided before the first stage function");
+	}
+
+	// Get the inline mode (functions are called by default, which lets the optimizer decide)
+	bool inlined{ false };
+	if (ctx->attr) {
+		const auto attr = ctx->attr->getText();
+		if (attr == "inline") {
+			inlined = true;
+		}
+		else if (attr != "noinline") {
+			ERROR(ctx->attr, mkstr("Unknown function attribute '%s', expected 'inline' or 'noinline'", attr.c_str()));
+		}
+	}
+
+	// Validate the name
+	const auto funcName = ctx->name->getText();
+	if (getUserFunction(funcName)) {
+		ERROR(ctx->name, mkstr("Duplicate function name '%s'", funcName.c_str()));
+	}
+	if (Functions::HasFunction(funcName)) {
+		ERROR(ctx->name, mkstr("Function name '%s' overlaps with builtin function", funcName.c_str()));
+	}
+	if (shader_->types().getType(funcName)) {
+		ERROR(ctx->name, mkstr("Function name '%s' overlaps with type name", funcName.c_str()));
+	}
+	if (GLSL_RESERVED_NAMES.count(funcName) || (funcName.find("gl_") == 0) ||
+			(funcName.find("__") != string::npos)) {
+		ERROR(ctx->name, mkstr("Function name '%s' is reserved", funcName.c_str()));
+	}
+	validateName(ctx->name);
+
+	// Validate the return type
+	const auto retTypeName = ctx->retType->getText();
+	const auto retType = shader_->types().getType(retTypeName);
+	if (!retType) {
+		ERROR(ctx->retType, mkstr("Unknown type: %s", shader_->types().lastError().c_str()));
+	}
+	if (!retType->isVoid() && !retType->isNumericType() && !retType->isBoolean()) {
+		ERROR(ctx->retType, "Functions must return a numeric or boolean type, or void");
+	}
+
+	// Parse the parameters into the function scope
+	auto func = std::make_unique<UserFunction>(funcName, inlined);
+	std::vector<FunctionType> argTypes{};
+	scopes_.pushFunctionScope();
+	for (const auto param : ctx->params) {
+		auto pVar = parseVariableDeclaration(param, false);
+		if (pVar.arraySize != 1) {
+			ERROR(param->arraySize, "Function parameters cannot be arrays");
+		}
+		if (!pVar.dataType->isNumericType() && !pVar.dataType->isBoolean()) {
+			ERROR(param->baseType, "Function parameters must be numeric or boolean types");
+		}
+		pVar.varType = VariableType::Parameter;
+		scopes_.addVariable(pVar);
+		argTypes.push_back(FunctionType{ param->baseType->getText() });
+		func->params.push_back({ pVar.dataType, pVar.name });
+	}
+	func->entry = FunctionEntry{ funcName, retTypeName, argTypes };
+
+	// Visit the function statements
+	FuncGenerator funcGen{ ShaderStages::None, options_->relaxedPrecision() };
+	funcGen_ = &funcGen;
+	userFunc_ = func.get();
+	const auto stmts = ctx->statementBlock()->statement();
+	for (size_t i = 0; i < stmts.size(); ++i) {
+		if (inlined && (i != (stmts.size() - 1)) && stmts[i]->controlStatement() &&
+				(stmts[i]->controlStatement()->getStart()->getText() == "return")) {
+			ERROR(stmts[i], "Inline functions can only return at the end of the function body");
+		}
+		visit(stmts[i]);
+	}
+	if (!retType->isVoid()) {
+		const auto last = stmts.empty() ? nullptr : stmts.back()->controlStatement();
+		if (!last || !last->value) {
+			ERROR(ctx->name, mkstr("Function '%s' must end with a return statement", funcName.c_str()));
+		}
+	}
+	userFunc_ = nullptr;
+	funcGen_ = nullptr;
+	scopes_.popScope();
+
+	// Register the function
+	func->body = funcGen.source().str();
+	userFunctions_.push_back(std::move(func));
+
+	return nullptr;
+}
+
 // ====================================================================================================================
 VISIT_FUNC(ShaderStageFunction)
 {
@@ -379,6 +812,17 @@ VISIT_FUNC(ShaderStageFunction)
 		ERROR(ctx->stage, mkstr("Duplicate shader function for stage '%s'", stageName.c_str()));
 	}
 
+	// Stages must match the shader kind
+	if (shader_->info().isCompute() && (stage != ShaderStages::Compute)) {
+		ERROR(ctx->stage, "Compute shaders can only have a compute stage function");
+	}
+	if (!shader_->info().isCompute() && (stage == ShaderStages::Compute)) {
+		ERROR(ctx->stage, "Graphics shaders cannot have a compute stage function");
+	}
+	if ((stage == ShaderStages::Compute) && !shader_->info().hasWorkgroupSize()) {
+		ERROR(ctx->stage, "Compute shaders must declare a workgroup size before the stage function");
+	}
+
 	// No support for tesc/tese/geom yet
 	if (stage == ShaderStages::TessControl) {
 		ERROR(ctx->stage, "Tessellation control stage is not yet supported");
@@ -390,6 +834,27 @@ VISIT_FUNC(ShaderStageFunction)
 		ERROR(ctx->stage, "Geometry stage is not yet supported");
 	}
 
+	// Validate and place push constants before the first stage function (all declarations are known by now)
+	auto& info = shader_->info();
+	if (!bool(info.stageMask())) {
+		if (options_->vertexPulling()) {
+			info.flags(info.flags() | ShaderFlags::VertexPulling);
+		}
+		info.layoutVertexInputs(options_->vertexPulling());
+
+		const auto pushSize = info.getPushConstantEnd(); // Includes alignment padding before the push constant
+		if (pushSize > options_->pushConstantSize()) {
+			ERROR(ctx->stage, mkstr("Push constants and binding indices (%u bytes) are larger than the push constant "
+				"budget (%u bytes)", pushSize, options_->pushConstantSize()));
+		}
+		if (info.hasUniform() && options_->promoteUniform()) {
+			const auto uSize = info.uniform().type->buffer.structType->userStruct.type->size();
+			if ((info.getPushUniformOffset() + uSize) <= options_->pushConstantSize()) {
+				info.flags(info.flags() | ShaderFlags::UniformPushConstant);
+			}
+		}
+	}
+
 	// Push the global scope for the stage
 	scopes_.pushGlobalScope(stage);
 	funcGen_ = shader_->getOrCreateFunctionGenerator(stage);
@@ -405,6 +870,17 @@ VISIT_FUNC(ShaderStageFunction)
 	scopes_.popScope();
 	funcGen_ = nullptr;
 
+	// Fragment side effects from storage writes
+	if (stage == ShaderStages::Fragment) {
+		const auto& binds = shader_->info().bindings();
+		const auto writes = std::any_of(binds.begin(), binds.end(), [](const BindingVariable& bind) {
+			return bind.isWrittenIn(ShaderStages::Fragment);
+		});
+		if (writes) {
+			shader_->info().flags(shader_->info().flags() | ShaderFlags::FragmentStorageWrite);
+		}
+	}
+
 	// Update shader info
 	shader_->info().stageMask(shader_->info().stageMask() | stage);
 
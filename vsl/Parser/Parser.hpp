@@ -9,6 +9,8 @@
 #include "../Shader.hpp"
 #include "../Grammar/VSLBaseVisitor.h"
 #include "./ScopeManager.hpp"
+#include "./Module.hpp"
+#include "./Func.hpp"
 #include "../Generator/FuncGenerator.hpp"
 
 #include <antlr4/CommonTokenStream.h>
@@ -16,6 +18,9 @@
 #include <antlr4/Token.h>
 #include <antlr4/tree/TerminalNode.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 #define VISIT_DECL(type) antlrcpp::Any visit##type(grammar::VSL::type##Context* ctx) override;
 
 
@@ -26,10 +31,10 @@ namespace vsl
 struct Literal final
 {
 public:
-	Literal() : u{ 0 }, type{ Unsigned } { }
-	Literal(uint64_t val) : u{ val }, type{ Unsigned } { }
-	Literal(int64_t val) : i{ val }, type{ Signed } { }
-	Literal(double val) : f{ val }, type{ Float } { }
+	Literal() : u{ 0 }, type{ Unsigned }, is16{ false } { }
+	Literal(uint64_t val, bool is16 = false) : u{ val }, type{ Unsigned }, is16{ is16 } { }
+	Literal(int64_t val, bool is16 = false) : i{ val }, type{ Signed }, is16{ is16 } { }
+	Literal(double val, bool is16 = false) : f{ val }, type{ Float }, is16{ is16 } { }
 
 	inline bool isNegative() const {
 		return (type == Float) ? f < 0 : (type == Signed) ? i < 0 : false;
@@ -47,6 +52,7 @@ public:
 		Signed,
 		Float
 	} type;
+	bool is16; // If the literal has a 16-bit suffix ('s', 'us', or 'hf')
 }; // struct Literal
 
 
@@ -75,7 +81,7 @@ public:
 	Parser(Shader* shader, const CompileOptions* options);
 	~Parser();
 
-	bool parse(const string& source);
+	bool parse(const string& source, const string& sourceDir);
 
 	/* Error */
 	inline const ShaderError& error() const { return error_; }
@@ -83,19 +89,43 @@ public:
 
 	/* Utilities */
 	void validateName(const antlr4::Token* name);
-	Variable parseVariableDeclaration(const grammar::VSL::VariableDeclarationContext* ctx, bool global);
+	Variable parseVariableDeclaration(const grammar::VSL::VariableDeclarationContext* ctx, bool global,
+		uint32 maxArraySize = Shader::MAX_ARRAY_SIZE);
 	Literal parseLiteral(const antlr4::Token* token);
 	void validateSwizzle(uint32 compCount, antlr4::tree::TerminalNode* swizzle);
+	bool isConstantExpression(antlr4::tree::ParseTree* tree) const;
+	void parseVertexAttributes(const grammar::VSL::ShaderInputOutputStatementContext* ctx, InterfaceVariable* var);
+	antlrcpp::Any visitAtomicCall(grammar::VSL::FunctionCallContext* ctx);
+	antlrcpp::Any visitUserCall(grammar::VSL::FunctionCallContext* ctx, const UserFunction* func,
+		const std::vector<SPtr<Expr>>& args);
+	const StructType* addStructType(const string& typeName, const std::vector<StructType::Member>& members,
+		const antlr4::Token* tk);
+
+	/* User Functions */
+	const UserFunction* getUserFunction(const string& name) const;
+
+	/* Modules */
+	string resolveModulePath(const string& baseDir, const string& importPath, const antlr4::Token* tk) const;
+	void importModule(const string& path, const antlr4::Token* importTk);
+	void checkModuleType(const ShaderType* type, const string& typeName, const antlr4::Token* tk) const;
+	void parseModule(const string& path, const string& source, ModuleInterface* module);
 
 	/* File Level Rules */
 	VISIT_DECL(File)
 	VISIT_DECL(ShaderTypeStatement)
+	VISIT_DECL(ShaderImportStatement)
 	VISIT_DECL(ShaderStructDefinition)
 	VISIT_DECL(ShaderInputOutputStatement)
 	VISIT_DECL(ShaderUniformStatement)
+	VISIT_DECL(ShaderPushStatement)
 	VISIT_DECL(ShaderBindingStatement)
 	VISIT_DECL(ShaderLocalStatement)
 	VISIT_DECL(ShaderSubpassInputStatement)
+	VISIT_DECL(ShaderDepthStatement)
+	VISIT_DECL(ShaderWorkgroupStatement)
+	VISIT_DECL(ShaderSharedStatement)
+	VISIT_DECL(ShaderConstantStatement)
+	VISIT_DECL(ShaderUserFunction)
 	VISIT_DECL(ShaderStageFunction)
 
 	/* Statement Rules */
@@ -127,6 +157,7 @@ public:
 	VISIT_DECL(CallAtom)
 	VISIT_DECL(LiteralAtom)
 	VISIT_DECL(NameAtom)
+	VISIT_DECL(FunctionCall)
 
 private:
 	/* Error */
@@ -156,6 +187,16 @@ private:
 	ScopeManager scopes_;
 	ShaderStages currentStage_;
 	FuncGenerator* funcGen_;
+	string sourceDir_;                     // The directory for resolving relative import paths
+	ModuleInterface* module_;              // The module interface being recorded, if parsing a module
+	std::vector<string> importStack_;      // The modules currently being imported, to detect cycles
+	std::unordered_set<string> imported_;  // The modules already imported, which are only imported once
+	std::unordered_map<string, std::unordered_set<string>> moduleTypes_; // The struct names visible to each module
+	std::unordered_set<string>* moduleScope_; // The struct names visible to the module being imported, if any
+	std::vector<UPtr<UserFunction>> userFunctions_; // The user-defined functions, in declaration order
+	UserFunction* userFunc_;               // The user function being parsed, if any
+	uint32 inlineUid_;                     // Unique id for the names in inlined function calls
+	bool forceCall_;                       // If user functions must be called instead of inlined (elif conditions)
 
 	VSL_NO_COPY(Parser)
 	VSL_NO_MOVE(Parser)
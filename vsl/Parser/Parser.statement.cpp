@@ -45,6 +45,12 @@ VISIT_FUNC(Statement)
 	else if (ctx->controlStatement()) {
 		visit(ctx->controlStatement());
 	}
+	else if (ctx->functionCall()) {
+		const auto call = VISIT_EXPR(ctx->functionCall());
+		if (!call->refString.empty()) { // Inlined void functions have no call to emit
+			funcGen_->emitCall(call->refString);
+		}
+	}
 
 	return nullptr;
 }
@@ -58,8 +64,11 @@ VISIT_FUNC(VariableDefinition)
 	if (var.arraySize != 1) {
 		ERROR(varDecl->arraySize, "Function-local variables cannot be arrays");
 	}
-	if (!var.dataType->isNumericType() && !var.dataType->isBoolean()) {
-		ERROR(varDecl->baseType, "Function-local variable must be numeric or boolean type");
+	if (!var.dataType->isNumericType() && !var.dataType->isBoolean() && !var.dataType->isBufferPtr()) {
+		ERROR(varDecl->baseType, "Function-local variable must be numeric, boolean, or BufferPtr type");
+	}
+	if (userFunc_ && var.dataType->isBufferPtr()) {
+		ERROR(varDecl->baseType, "User functions cannot declare BufferPtr variables"); // Writes are not tracked per stage
 	}
 
 	// Visit and check expression
@@ -70,9 +79,12 @@ VISIT_FUNC(VariableDefinition)
 			var.dataType->getVSLName().c_str()));
 	}
 
-	// Add the variable
+	// Add the variable (the pointed-to struct must be declared in every stage with pointer locals)
 	var.varType = VariableType::Private;
 	scopes_.addVariable(var);
+	if (var.dataType->isBufferPtr()) {
+		shader_->info().addBufferPtrType(var.dataType->buffer.structType->userStruct.type, currentStage_);
+	}
 
 	// Emit declaration and assignment
 	const auto typeStr = var.dataType->getGLSLName();
@@ -89,13 +101,19 @@ VISIT_FUNC(VariableDeclaration)
 	if (var.arraySize != 1) {
 		ERROR(ctx->arraySize, "Function-local variables cannot be arrays");
 	}
-	if (!var.dataType->isNumericType() && !var.dataType->isBoolean()) {
-		ERROR(ctx->baseType, "Function-local variable must be numeric or boolean type");
+	if (!var.dataType->isNumericType() && !var.dataType->isBoolean() && !var.dataType->isBufferPtr()) {
+		ERROR(ctx->baseType, "Function-local variable must be numeric, boolean, or BufferPtr type");
+	}
+	if (userFunc_ && var.dataType->isBufferPtr()) {
+		ERROR(ctx->baseType, "User functions cannot declare BufferPtr variables"); // Writes are not tracked per stage
 	}
 
-	// Add the variable
+	// Add the variable (the pointed-to struct must be declared in every stage with pointer locals)
 	var.varType = VariableType::Private;
 	scopes_.addVariable(var);
+	if (var.dataType->isBufferPtr()) {
+		shader_->info().addBufferPtrType(var.dataType->buffer.structType->userStruct.type, currentStage_);
+	}
 
 	// Emit declaration and assignment
 	funcGen_->emitDeclaration(var.dataType, var.name);
@@ -133,7 +151,8 @@ VISIT_FUNC(Assignment)
 		const string prefix = etype->isSigned() ? "i" : etype->isUnsigned() ? "u" : "";
 		const auto valstr =
 			(dims == 1) ? mkstr("%svec4(%s, 0, 0, 0)", prefix.c_str(), expr->refString.c_str()) :
-			(dims == 2) ? mkstr("%svec4(%s, 0, 0)", prefix.c_str(), expr->refString.c_str()) : expr->refString;
+			(dims == 2) ? mkstr("%svec4(%s, 0, 0)", prefix.c_str(), expr->refString.c_str()) :
+			(dims == 3) ? mkstr("%svec4(%s, 0)", prefix.c_str(), expr->refString.c_str()) : expr->refString;
 
 		// Emit image store
 		funcGen_->emitImageStore(left->refString, valstr);
@@ -153,6 +172,16 @@ VISIT_FUNC(Assignment)
 				optxt.c_str(), ltype->getVSLName().c_str(), etype->getVSLName().c_str()));
 		}
 		funcGen_->emitAssignment(left->refString, optxt, expr->refString);
+
+		// Compound assignments also read the destination
+		auto root = ctx->lval;
+		while (!root->name) {
+			root = root->val;
+		}
+		const auto rootVar = scopes_.getVariable(root->name->getText());
+		if (rootVar && (rootVar->varType == VariableType::Binding) && rootVar->dataType->isBufferType()) {
+			shader_->info().getBinding(rootVar->extra.binding.slot)->readMask |= currentStage_;
+		}
 	}
 
 	return nullptr;
@@ -187,17 +216,27 @@ VISIT_FUNC(Lvalue)
 			else if (var->dataType->isBufferType()) {
 				funcGen_->emitBindingIndex(var->extra.binding.slot);
 				outname = mkstr("%s[_bidx%u_]", var->name.c_str(), uint32(var->extra.binding.slot));
-				shader_->info().getBinding(var->extra.binding.slot)->stageMask |= currentStage_;
+				const auto binding = shader_->info().getBinding(var->extra.binding.slot);
+				binding->stageMask |= currentStage_;
+				binding->writeMask |= currentStage_;
 			}
 			else {
 				const auto table = NameGeneration::GetBindingTableName(var->dataType);
 				funcGen_->emitBindingIndex(var->extra.binding.slot);
 				outname = mkstr("(%s[_bidx%u_])", table.c_str(), uint32(var->extra.binding.slot));
-				shader_->info().getBinding(var->extra.binding.slot)->stageMask |= currentStage_;
+				const auto binding = shader_->info().getBinding(var->extra.binding.slot);
+				binding->stageMask |= currentStage_;
+				binding->writeMask |= currentStage_;
 			}
 		} break;
 		case VariableType::Builtin: {
 			outname = NameGeneration::GetGLSLBuiltinName(var->name);
+			if (var->name == "$FragDepth") {
+				shader_->info().flags(shader_->info().flags() | ShaderFlags::FragmentDepthWrite);
+			}
+			else if (var->name == "$PrimitiveShadingRate") {
+				shader_->info().flags(shader_->info().flags() | ShaderFlags::PrimitiveShadingRate);
+			}
 		} break;
 		case VariableType::Local: {
 			const auto inout = (var->extra.local.sourceStage == currentStage_) ? "out" : "in";
@@ -255,6 +294,18 @@ VISIT_FUNC(Lvalue)
 			refStr = mkstr("imageStore(%s, %s, {})", left->refString.c_str(), index->refString.c_str());
 			refType = ltype->texel.format->asDataType();
 		}
+		else if (ltype->isBufferPtr()) {
+			if (!itype->isScalar()) {
+				ERROR(ctx->index, "BufferPtr expects a scalar integer indexer");
+			}
+			refStr = mkstr("(%s._data_[%s])", left->refString.c_str(), index->refString.c_str());
+			refType = shader_->types().getType(ltype->buffer.structType->userStruct.type->name());
+
+			// Pointer writes have no binding to track, so record the fragment side effect directly
+			if (currentStage_ == ShaderStages::Fragment) {
+				shader_->info().flags(shader_->info().flags() | ShaderFlags::FragmentStorageWrite);
+			}
+		}
 		else if (ltype->isNumericType()) {
 			if (ltype->isMatrix()) { // Matrix
 				refStr = left->refString;
@@ -295,8 +346,9 @@ VISIT_FUNC(Lvalue)
 
 			// Return member
 			const auto refStr = mkstr("(%s.%s)", left->refString.c_str(), ident.c_str());
-			const auto refType = TypeList::GetNumericType(memType->type->baseType, memType->type->numeric.size,
-				memType->type->numeric.dims[0], memType->type->numeric.dims[1]);
+			const auto refType = memType->type->isBufferPtr() ? memType->type :
+				TypeList::GetNumericType(memType->type->baseType, memType->type->numeric.size,
+					memType->type->numeric.dims[0], memType->type->numeric.dims[1]);
 			return MAKE_EXPR(refStr, refType, memType->arraySize);
 		}
 		else if (ltype->isVector()) {
@@ -367,8 +419,11 @@ VISIT_FUNC(IfStatement)
 // ====================================================================================================================
 VISIT_FUNC(ElifStatement)
 {
-	// Check the condition
+	// Check the condition (inlined bodies cannot be placed before an 'else if', so they are called instead)
+	const auto oldForceCall = forceCall_;
+	forceCall_ = true;
 	const auto cond = VISIT_EXPR(ctx->cond);
+	forceCall_ = oldForceCall;
 	if (cond->arraySize != 1) {
 		ERROR(ctx->cond, "Elif statement condition cannot be an array");
 	}
@@ -499,17 +554,61 @@ VISIT_FUNC(ForLoopStatement)
 // ====================================================================================================================
 VISIT_FUNC(ControlStatement)
 {
-	const auto keyword = ctx->getText();
+	const auto keyword = ctx->getStart()->getText();
 
 	if ((keyword == "break") || (keyword == "continue")) {
 		if (!scopes_.inLoop()) {
 			ERROR(ctx, mkstr("Statement '%s' only allowed in loops", keyword.c_str()));
 		}
 	}
+	else if (keyword == "return") {
+		if (!userFunc_) {
+			if (ctx->value) {
+				ERROR(ctx->value, "Stage functions cannot return a value");
+			}
+		}
+		else {
+			// Check the return value
+			const auto retType = userFunc_->entry.retType.type;
+			SPtr<Expr> value{};
+			if (retType->isVoid()) {
+				if (ctx->value) {
+					ERROR(ctx->value, "Void functions cannot return a value");
+				}
+			}
+			else {
+				if (!ctx->value) {
+					ERROR(ctx, mkstr("Function must return a value of type '%s'", retType->getVSLName().c_str()));
+				}
+				value = VISIT_EXPR(ctx->value);
+				if ((value->arraySize != 1) || !value->type->hasImplicitCast(retType)) {
+					ERROR(ctx->value, mkstr("Cannot return type '%s' from function with return type '%s'",
+						value->type->getVSLName().c_str(), retType->getVSLName().c_str()));
+				}
+			}
+
+			// Inlined functions assign the result instead of returning
+			if (userFunc_->inlined) {
+				if (scopes_.depth() > 1) {
+					ERROR(ctx, "Inline functions can only return at the end of the function body");
+				}
+				if (value) {
+					funcGen_->emitAssignment("_return_", "=", value->refString);
+				}
+				return nullptr;
+			}
+			funcGen_->emitControlStatement(value ? ("return " + value->refString) : keyword);
+			return nullptr;
+		}
+	}
 	else if (keyword == "discard") {
+		if (userFunc_) {
+			ERROR(ctx, "Statement 'discard' is not allowed in user functions");
+		}
 		if (currentStage_ != ShaderStages::Fragment) {
 			ERROR(ctx, "Statement 'discard' only allowed in fragment stage");
 		}
+		shader_->info().flags(shader_->info().flags() | ShaderFlags::FragmentDiscard);
 	}
 
 	funcGen_->emitControlStatement(keyword);
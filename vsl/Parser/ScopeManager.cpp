@@ -78,9 +78,17 @@ void ScopeManager::pushGlobalScope(ShaderStages stage)
 		case VariableType::Binding: {
 			scope->variables().push_back(glob);
 		} break;
+		case VariableType::Push: {
+			scope->variables().push_back(glob);
+		} break;
 		case VariableType::Constant: {
 			scope->variables().push_back(glob);
 		} break;
+		case VariableType::Shared: {
+			if (stage == ShaderStages::Compute) {
+				scope->variables().push_back(glob);
+			}
+		} break;
 		case VariableType::Local: {
 			// Always add for now, until mroe stages are supported
 			scope->variables().push_back(glob);
@@ -89,6 +97,22 @@ void ScopeManager::pushGlobalScope(ShaderStages stage)
 	}
 }
 
+// ====================================================================================================================
+void ScopeManager::pushFunctionScope()
+{
+	if (scopes_.size() != 0) {
+		throw std::runtime_error("COMPILER BUG - Invalid scope push");
+	}
+	auto& scope = scopes_.emplace_back(std::make_unique<Scope>());
+
+	// Only the constants are visible, so the function is valid in any stage
+	for (const auto& glob : allGlobals_) {
+		if (glob.varType == VariableType::Constant) {
+			scope->variables().push_back(glob);
+		}
+	}
+}
+
 // ====================================================================================================================
 void ScopeManager::pushScope(Scope::ScopeType type)
 {
@@ -189,9 +213,11 @@ void ScopeManager::PopulateBuiltins(ShaderStages stage, std::vector<Variable>& v
 		vars.push_back({ "$DrawIndex", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
 		vars.push_back({ "$VertexBase", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
 		vars.push_back({ "$InstanceBase", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
+		vars.push_back({ "$ViewIndex", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
 		
 		vars.push_back({ "$Position", VariableType::Builtin, &bit.at("float4"), 1, Variable::WRITEONLY });
 		vars.push_back({ "$PointSize", VariableType::Builtin, &bit.at("float"), 1, Variable::WRITEONLY });
+		vars.push_back({ "$PrimitiveShadingRate", VariableType::Builtin, &bit.at("int"), 1, Variable::WRITEONLY });
 	}
 	else if (stage == ShaderStages::TessControl) {
 		// TODO
@@ -207,7 +233,25 @@ void ScopeManager::PopulateBuiltins(ShaderStages stage, std::vector<Variable>& v
 		vars.push_back({ "$FrontFacing", VariableType::Builtin, &bit.at("bool"), 1, Variable::READONLY });
 		vars.push_back({ "$PointCoord", VariableType::Builtin, &bit.at("float2"), 1, Variable::READONLY });
 		vars.push_back({ "$PrimitiveID", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
+		vars.push_back({ "$ViewIndex", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
+		vars.push_back({ "$ShadingRate", VariableType::Builtin, &bit.at("int"), 1, Variable::READONLY });
+
+		vars.push_back({ "$FragDepth", VariableType::Builtin, &bit.at("float"), 1, Variable::WRITEONLY });
 	}
+	else if (stage == ShaderStages::Compute) {
+		vars.push_back({ "$GlobalInvocationID", VariableType::Builtin, &bit.at("uint3"), 1, Variable::READONLY });
+		vars.push_back({ "$LocalInvocationID", VariableType::Builtin, &bit.at("uint3"), 1, Variable::READONLY });
+		vars.push_back({ "$LocalInvocationIndex", VariableType::Builtin, &bit.at("uint"), 1, Variable::READONLY });
+		vars.push_back({ "$WorkgroupID", VariableType::Builtin, &bit.at("uint3"), 1, Variable::READONLY });
+		vars.push_back({ "$NumWorkgroups", VariableType::Builtin, &bit.at("uint3"), 1, Variable::READONLY });
+		vars.push_back({ "$WorkgroupSize", VariableType::Builtin, &bit.at("uint3"), 1, Variable::READONLY });
+		vars.push_back({ "$SubgroupID", VariableType::Builtin, &bit.at("uint"), 1, Variable::READONLY });
+		vars.push_back({ "$SubgroupCount", VariableType::Builtin, &bit.at("uint"), 1, Variable::READONLY });
+	}
+
+	// Subgroup builtins are available in all stages
+	vars.push_back({ "$SubgroupSize", VariableType::Builtin, &bit.at("uint"), 1, Variable::READONLY });
+	vars.push_back({ "$SubgroupInvocationID", VariableType::Builtin, &bit.at("uint"), 1, Variable::READONLY });
 }
 
 } // namespace vsl
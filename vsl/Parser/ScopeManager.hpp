@@ -21,9 +21,11 @@ enum class VariableType
 	Input,      // Vertex input
 	Output,     // Fragment output
 	Binding,    // Uniform resource binding
+	Push,       // Push constant block
 	Builtin,    // A stage-specific builtin variable
 	Constant,   // Specialization constant
 	Local,      // Local value passed between stages
+	Shared,     // Compute workgroup shared variable
 	Parameter,  // Parameter to a function
 	Private     // Private within a function
 }; // enum class VariableType
@@ -106,12 +108,14 @@ public:
 
 	/* Scopes */
 	void pushGlobalScope(ShaderStages stage); // Starts a new scope stack for the given stage
+	void pushFunctionScope(); // Starts a new scope stack for a user function, which can only see constants
 	void pushScope(Scope::ScopeType type); // Push a new scope to the stack, must already have an active scope stack
 	void popScope();
 	bool hasName(const string& name) const; // If the name exists in the current scope stack
 	const Variable* getVariable(const string& name) const;
 	void addVariable(const Variable& var);
 	bool inLoop() const; // If the scope stack contains a loop scope at any depth
+	inline uint32 depth() const { return uint32(scopes_.size()); }
 
 private:
 	static void PopulateBuiltins(ShaderStages stage, std::vector<Variable>& vars);
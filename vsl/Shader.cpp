@@ -10,8 +10,12 @@
 #include "./Generator/FuncGenerator.hpp"
 #include "./Generator/StageGenerator.hpp"
 
+#include <cctype>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <future>
 
 namespace fs = std::filesystem;
 
@@ -68,12 +72,21 @@ bool Shader::parseFile(const string& path, const CompileOptions& options)
 	std::stringstream fileContents{};
 	fileContents << inFile.rdbuf();
 
-	// Parse the loaded source
-	return parseString(fileContents.str(), options);
+	// Parse the loaded source (imports are relative to the file)
+	return parseSource(fileContents.str(), inPath.parent_path().string(), options);
 }
 
 // ====================================================================================================================
 bool Shader::parseString(const string& source, const CompileOptions& options)
+{
+	// Imports are relative to the working directory
+	std::error_code ioError{};
+	const auto workingDir = fs::current_path(ioError);
+	return parseSource(source, ioError ? string{} : workingDir.string(), options);
+}
+
+// ====================================================================================================================
+bool Shader::parseSource(const string& source, const string& sourceDir, const CompileOptions& options)
 {
 	// Validate state
 	if (isParsed()) {
@@ -87,19 +100,33 @@ bool Shader::parseString(const string& source, const CompileOptions& options)
 	try {
 		// Perform parsing
 		Parser parser{ this, &options };
-		if (!parser.parse(source)) {
+		if (!parser.parse(source, sourceDir)) {
 			lastError_ = parser.error();
 			return false;
 		}
 
 		// After-parse validation
-		if (!bool(info_.stageMask() & ShaderStages::Vertex)) {
-			lastError_ = { "Shader is missing required vertex stage", 0, 0 };
-			return false;
+		if (info_.isCompute()) {
+			if (!bool(info_.stageMask() & ShaderStages::Compute)) {
+				lastError_ = { "Shader is missing required compute stage", 0, 0 };
+				return false;
+			}
 		}
-		if (!bool(info_.stageMask() & ShaderStages::Fragment)) {
-			lastError_ = { "Shader is missing required fragment stage", 0, 0 };
-			return false;
+		else {
+			if (!bool(info_.stageMask() & ShaderStages::Vertex)) {
+				lastError_ = { "Shader is missing required vertex stage", 0, 0 };
+				return false;
+			}
+			if (!bool(info_.stageMask() & ShaderStages::Fragment)) {
+				lastError_ = { "Shader is missing required fragment stage", 0, 0 };
+				return false;
+			}
+		}
+
+		// Post-parse analysis
+		info_.packLocals();
+		if (options_.earlyFragmentTests() && info_.canUseEarlyFragmentTests()) {
+			info_.flags(info_.flags() | ShaderFlags::EarlyFragmentTests);
 		}
 	}
 	catch (const std::exception& ex) {
@@ -171,6 +198,15 @@ bool Shader::generate()
 				return false;
 			}
 		}
+		if (bool(info_.stageMask() & ShaderStages::Compute)) {
+			auto& gen = (stages_[ShaderStages::Compute] =
+				std::make_unique<StageGenerator>(&options_, ShaderStages::Compute));
+			gen->generate(*(functions_[ShaderStages::Compute]), info_);
+			if (!gen->save()) {
+				lastError_ = { "Failed to save compute glsl" };
+				return false;
+			}
+		}
 	}
 	catch (const std::exception& ex) {
 		lastError_ = { mkstr("Unhandled generator exception - %s", ex.what()) };
@@ -224,6 +260,11 @@ bool Shader::compile()
 			lastError_ = ShaderError(compiler.lastError());
 			return false;
 		}
+		if (bool(info_.stageMask() & ShaderStages::Compute) &&
+			!compiler.compileStage(*stages_[ShaderStages::Compute])) {
+			lastError_ = ShaderError(compiler.lastError());
+			return false;
+		}
 
 		// Write final output file
 		compiler.writeOutput();
@@ -237,6 +278,241 @@ bool Shader::compile()
 	return true;
 }
 
+// ====================================================================================================================
+bool Shader::compileVariants(const std::vector<ShaderVariant>& variants)
+{
+	static const ShaderStages STAGES[]{ ShaderStages::Vertex, ShaderStages::TessControl, ShaderStages::TessEval,
+		ShaderStages::Geometry, ShaderStages::Fragment, ShaderStages::Compute };
+
+	// Validate state
+	if (!isParsed()) {
+		lastError_ = ShaderError("Cannot compile variants of a shader before parsing it");
+		return false;
+	}
+	if (isGenerated()) {
+		lastError_ = ShaderError("Cannot compile variants of a shader that has already been generated");
+		return false;
+	}
+	for (uint32 vi = 0; vi < variants.size(); ++vi) {
+		if (variants[vi].name.empty()) {
+			lastError_ = ShaderError(mkstr("Variant %u does not have a name", vi));
+			return false;
+		}
+		for (uint32 vj = 0; vj < vi; ++vj) {
+			if (variants[vi].name == variants[vj].name) {
+				lastError_ = ShaderError(mkstr("Duplicate variant name '%s'", variants[vi].name.c_str()));
+				return false;
+			}
+		}
+	}
+
+	// Save the unbaked state to restore between variants
+	const auto defaults = info_.constants();
+	const uint32 defaultSize[3]{ info_.workgroupSize()[0], info_.workgroupSize()[1], info_.workgroupSize()[2] };
+	const uint32 defaultIds[3]{
+		info_.workgroupSizeIds()[0], info_.workgroupSizeIds()[1], info_.workgroupSizeIds()[2] };
+	const auto restoreDefaults = [&]() {
+		info_.constants(defaults);
+		info_.workgroupSize(defaultSize[0], defaultSize[1], defaultSize[2]);
+		info_.workgroupSizeIds(defaultIds[0], defaultIds[1], defaultIds[2]);
+	};
+
+	// Per-variant state (unique is the index of the first variant with identical generated source)
+	struct VariantState final
+	{
+		CompileOptions options;
+		std::unordered_map<ShaderStages, UPtr<StageGenerator>> stages;
+		string source;
+		size_t unique;
+	};
+	std::vector<VariantState> states{ variants.size() };
+
+	try {
+		// Generate each variant and deduplicate by the generated source
+		for (size_t vi = 0; vi < variants.size(); ++vi) {
+			auto& state = states[vi];
+			state.options = options_;
+			state.options.outputFile(GetVariantOutputFile(options_.outputFile(), variants[vi].name));
+			if (!applyVariant(variants[vi], defaults, defaultSize, defaultIds)) {
+				restoreDefaults();
+				return false;
+			}
+
+			for (const auto stage : STAGES) {
+				if (!bool(info_.stageMask() & stage)) {
+					continue;
+				}
+				auto& gen = (state.stages[stage] = std::make_unique<StageGenerator>(&state.options, stage));
+				gen->generate(*(functions_[stage]), info_);
+				if (!gen->save()) {
+					lastError_ = { mkstr("Failed to save %s glsl for variant '%s'", ShaderStageToStr(stage).c_str(),
+						variants[vi].name.c_str()) };
+					restoreDefaults();
+					return false;
+				}
+				state.source += gen->source().str();
+			}
+
+			state.unique = vi;
+			for (size_t vj = 0; vj < vi; ++vj) {
+				if ((states[vj].unique == vj) && (states[vj].source == state.source)) {
+					state.unique = vj;
+					break;
+				}
+			}
+		}
+
+		// Stop after generating the variant sources if compilation is disabled
+		if (options_.noCompile()) {
+			restoreDefaults();
+			progress_.generated = true;
+			progress_.compiled = true;
+			return true;
+		}
+
+		// Compile the unique variants in parallel
+		std::vector<UPtr<Compiler>> compilers{ variants.size() };
+		std::vector<std::future<string>> tasks{};
+		for (size_t vi = 0; vi < variants.size(); ++vi) {
+			if (states[vi].unique != vi) {
+				continue;
+			}
+			compilers[vi] = std::make_unique<Compiler>(this, &states[vi].options);
+			tasks.push_back(std::async(std::launch::async, [&state = states[vi], compiler = compilers[vi].get()]() {
+				for (const auto& pair : state.stages) {
+					if (!compiler->compileStage(*pair.second)) {
+						return compiler->lastError();
+					}
+				}
+				return string{};
+			}));
+		}
+		string compileError{};
+		for (auto& task : tasks) {
+			const auto err = task.get();
+			if (compileError.empty() && !err.empty()) {
+				compileError = err;
+			}
+		}
+		if (!compileError.empty()) {
+			lastError_ = ShaderError(compileError);
+			restoreDefaults();
+			return false;
+		}
+
+		// Write the outputs with the reflection info of each variant
+		for (size_t vi = 0; vi < variants.size(); ++vi) {
+			applyVariant(variants[vi], defaults, defaultSize, defaultIds);
+			compilers[states[vi].unique]->writeOutput(states[vi].options.outputFile());
+		}
+	}
+	catch (const std::exception& ex) {
+		lastError_ = { mkstr("Unhandled variant exception - %s", ex.what()) };
+		restoreDefaults();
+		return false;
+	}
+	restoreDefaults();
+
+	progress_.generated = true;
+	progress_.compiled = true;
+	return true;
+}
+
+// ====================================================================================================================
+string Shader::GetVariantOutputFile(const string& outputFile, const string& variantName)
+{
+	fs::path path{ outputFile };
+	path.replace_filename(path.stem().string() + '.' + variantName + path.extension().string());
+	return path.string();
+}
+
+// ====================================================================================================================
+bool Shader::applyVariant(const ShaderVariant& variant, const std::vector<ConstantVariable>& defaults,
+	const uint32* defaultSize, const uint32* defaultIds)
+{
+	// Reset to the unbaked state
+	info_.constants(defaults);
+	uint32 size[3]{ defaultSize[0], defaultSize[1], defaultSize[2] };
+	uint32 ids[3]{ defaultIds[0], defaultIds[1], defaultIds[2] };
+
+	// Parse and bake the values
+	for (const auto& [name, valueStr] : variant.values) {
+		const auto cnst = info_.getConstant(name);
+		if (!cnst) {
+			lastError_ = ShaderError(mkstr("Variant '%s' - no constant with name '%s'", variant.name.c_str(),
+				name.c_str()));
+			return false;
+		}
+
+		const char* const beg = valueStr.c_str();
+		char* end{ nullptr };
+		bool valid{ true };
+		errno = 0;
+		const auto isHex = (valueStr.length() > 1) && (valueStr[0] == '0') && (std::tolower(valueStr[1]) == 'x');
+		const auto base = isHex ? 16 : 10; // Matches the parser, which reads a leading zero as decimal
+		if (cnst->type->isBoolean()) {
+			valid = (valueStr == "true") || (valueStr == "false");
+			cnst->value = (valueStr == "true") ? 1 : 0;
+		}
+		else if (cnst->type->isFloat()) {
+			const auto fval = float(std::strtod(beg, &end));
+			std::memcpy(&cnst->value, &fval, sizeof(float));
+		}
+		else if (cnst->type->isSigned()) {
+			const auto ival = std::strtoll(beg, &end, base);
+			valid = (ival >= INT32_MIN) && (ival <= INT32_MAX);
+			cnst->value = uint32(int32(ival));
+		}
+		else {
+			const auto uval = std::strtoull(beg, &end, base);
+			valid = (valueStr[0] != '-') && (uval <= UINT32_MAX);
+			cnst->value = uint32(uval);
+			if (end && ((*end == 'u') || (*end == 'U'))) {
+				++end;
+			}
+		}
+		if (!valid || (errno == ERANGE) || (end && ((end == beg) || (*end != '\0')))) {
+			lastError_ = ShaderError(mkstr("Variant '%s' - invalid value '%s' for constant '%s'",
+				variant.name.c_str(), valueStr.c_str(), name.c_str()));
+			return false;
+		}
+		cnst->baked = true;
+
+		// Baked workgroup sizes become literal sizes
+		for (uint32 i = 0; i < 3; ++i) {
+			if (ids[i] == cnst->id) {
+				if (cnst->type->isSigned() && (int32(cnst->value) <= 0)) {
+					lastError_ = ShaderError(mkstr("Variant '%s' - workgroup size cannot be zero or negative",
+						variant.name.c_str()));
+					return false;
+				}
+				size[i] = cnst->value;
+				ids[i] = UINT32_MAX;
+			}
+		}
+	}
+
+	// Validate the workgroup size
+	if (info_.isCompute()) {
+		for (uint32 i = 0; i < 3; ++i) {
+			if ((size[i] == 0) || (size[i] > MAX_WORKGROUP_SIZE[i])) {
+				lastError_ = ShaderError(mkstr("Variant '%s' - workgroup size %u is out of range",
+					variant.name.c_str(), size[i]));
+				return false;
+			}
+		}
+		if ((size[0] * size[1] * size[2]) > MAX_WORKGROUP_INVOCATIONS) {
+			lastError_ = ShaderError(mkstr("Variant '%s' - workgroup has more than the max allowed %u invocations",
+				variant.name.c_str(), MAX_WORKGROUP_INVOCATIONS));
+			return false;
+		}
+	}
+	info_.workgroupSize(size[0], size[1], size[2]);
+	info_.workgroupSizeIds(ids[0], ids[1], ids[2]);
+
+	return true;
+}
+
 // ====================================================================================================================
 FuncGenerator* Shader::getOrCreateFunctionGenerator(ShaderStages stage)
 {
@@ -245,7 +521,7 @@ FuncGenerator* Shader::getOrCreateFunctionGenerator(ShaderStages stage)
 		return it->second.get();
 	}
 	else {
-		return (functions_[stage] = std::make_unique<FuncGenerator>(stage)).get();
+		return (functions_[stage] = std::make_unique<FuncGenerator>(stage, options_.relaxedPrecision())).get();
 	}
 }
 
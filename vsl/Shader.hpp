@@ -45,6 +45,12 @@ public:
 		, saveBytecode_{ false }
 		, disableOptimization_{ false }
 		, noCompile_{ false }
+		, earlyFragmentTests_{ false }
+		, reorderStructs_{ false }
+		, promoteUniform_{ false }
+		, pushConstantSize_{ DefaultPushConstantSize }
+		, vertexPulling_{ false }
+		, relaxedPrecision_{ false }
 	{ }
 	~CompileOptions() { }
 
@@ -55,10 +61,18 @@ public:
 	DECL_GETTER_SETTER(bool, saveBytecode)
 	DECL_GETTER_SETTER(bool, disableOptimization)
 	DECL_GETTER_SETTER(bool, noCompile)
+	DECL_GETTER_SETTER(bool, earlyFragmentTests)
+	DECL_GETTER_SETTER(bool, reorderStructs)
+	DECL_GETTER_SETTER(bool, promoteUniform)
+	DECL_GETTER_SETTER(uint32, pushConstantSize)
+	DECL_GETTER_SETTER(bool, vertexPulling)
+	DECL_GETTER_SETTER(bool, relaxedPrecision)
 
 public:
 	// These limits require VK_EXT_descriptor_indexing for some implementations (mostly Intel integrated)
 	static constexpr BindingTableSizes DefaultTableSizes{ 8192, 128, 512, 128, 128 };
+	// The minimum push constant size guaranteed by Vulkan
+	static constexpr uint32 DefaultPushConstantSize{ 128 };
 
 private:
 	string outputFile_;
@@ -67,6 +81,12 @@ private:
 	bool saveBytecode_;
 	bool disableOptimization_;
 	bool noCompile_;
+	bool earlyFragmentTests_; // Force early fragment tests for fragment stages without side effects
+	bool reorderStructs_;     // Reorder struct members to minimize padding (changes the declared layout)
+	bool promoteUniform_;     // Place the uniform in push constants if it fits in the push constant budget
+	uint32 pushConstantSize_; // The push constant budget in bytes
+	bool vertexPulling_;      // Fetch vertex inputs from a bindless buffer instead of vertex attributes
+	bool relaxedPrecision_;   // Declare function-local float values as mediump (RelaxedPrecision)
 }; // class CompileOptions
 
 
@@ -99,6 +119,21 @@ private:
 }; // class ShaderError
 
 
+// Describes a shader variant, which bakes a set of specialization constants to fixed values
+struct ShaderVariant final
+{
+public:
+	ShaderVariant() : name{}, values{} { }
+	ShaderVariant(const string& name, const std::vector<std::pair<string, string>>& values)
+		: name{ name }, values{ values }
+	{ }
+
+public:
+	string name;                                   // The variant name, inserted into the output file name
+	std::vector<std::pair<string, string>> values; // The constant names and literal values to bake into the variant
+}; // struct ShaderVariant
+
+
 // Represents a shader program, which can have successive transforms (parse/generate/compile) applied to it
 class VSL_API Shader final
 {
@@ -114,6 +149,10 @@ public:
 	bool parseString(const string& source, const CompileOptions& options);
 	bool generate();
 	bool compile();
+	bool compileVariants(const std::vector<ShaderVariant>& variants); // Generates and compiles after a single parse
+
+	/* Variants */
+	static string GetVariantOutputFile(const string& outputFile, const string& variantName);
 
 	/* Error */
 	inline const ShaderError& lastError() const { return lastError_; }
@@ -127,6 +166,11 @@ public:
 	FuncGenerator* getOrCreateFunctionGenerator(ShaderStages stage);
 	const FuncGenerator* getFunctionGenerator(ShaderStages stage) const;
 
+private:
+	bool parseSource(const string& source, const string& sourceDir, const CompileOptions& options);
+	bool applyVariant(const ShaderVariant& variant, const std::vector<ConstantVariable>& defaults,
+		const uint32* defaultSize, const uint32* defaultIds);
+
 private:
 	CompileOptions options_;
 	struct {
@@ -148,6 +192,11 @@ public:
 	static constexpr uint32 MAX_FRAGMENT_OUTPUTS{ 8u };  // Maximum number of fragment output slots
 	static constexpr uint32 MAX_BINDINGS{ 32u };         // Maximum number of resource bindings
 	static constexpr uint32 MAX_SUBPASS_INPUTS{ 4u };    // Maximum number of subpass inputs
+	static constexpr uint32 MAX_WORKGROUP_SIZE[3]{ 1024u, 1024u, 64u }; // Max compute workgroup size per dimension
+	static constexpr uint32 MAX_WORKGROUP_INVOCATIONS{ 1024u };         // Max total compute workgroup invocations
+	static constexpr uint32 MAX_SHARED_ARRAY_SIZE{ 8192u };             // Max length for a shared array
+	static constexpr uint32 MAX_SHARED_SIZE{ 32768u };                  // Max size in bytes for all shared variables
+	static constexpr uint32 MAX_CONSTANTS{ 32u };                       // Max specialization constants (and ids)
 }; // class Shader
 
 } // namespace vsl
@@ -7,6 +7,7 @@
 #include "./ShaderInfo.hpp"
 
 #include <algorithm>
+#include <iterator>
 
 
 namespace vsl
@@ -30,6 +31,9 @@ ShaderStages StrToShaderStage(const string& str)
 	if (str == "frag") {
 		return ShaderStages::Fragment;
 	}
+	if (str == "comp") {
+		return ShaderStages::Compute;
+	}
 	return ShaderStages::None;
 }
 
@@ -43,6 +47,38 @@ string ShaderStageToStr(ShaderStages stage)
 	case ShaderStages::TessEval: return "tese";
 	case ShaderStages::Geometry: return "geom";
 	case ShaderStages::Fragment: return "frag";
+	case ShaderStages::Compute: return "comp";
+	default: return "";
+	}
+}
+
+// ====================================================================================================================
+DepthMode StrToDepthMode(const string& str)
+{
+	if (str == "any") {
+		return DepthMode::Any;
+	}
+	if (str == "greater") {
+		return DepthMode::Greater;
+	}
+	if (str == "less") {
+		return DepthMode::Less;
+	}
+	if (str == "unchanged") {
+		return DepthMode::Unchanged;
+	}
+	return DepthMode::None;
+}
+
+// ====================================================================================================================
+string DepthModeToStr(DepthMode mode)
+{
+	switch (mode)
+	{
+	case DepthMode::Any: return "any";
+	case DepthMode::Greater: return "greater";
+	case DepthMode::Less: return "less";
+	case DepthMode::Unchanged: return "unchanged";
 	default: return "";
 	}
 }
@@ -51,13 +87,25 @@ string ShaderStageToStr(ShaderStages stage)
 // ====================================================================================================================
 // ====================================================================================================================
 ShaderInfo::ShaderInfo()
-	: stageMask_{ ShaderStages::None }
+	: kind_{ ShaderKind::Graphics }
+	, stageMask_{ ShaderStages::None }
+	, flags_{ ShaderFlags::None }
+	, depthMode_{ DepthMode::None }
+	, subgroupOps_{ SubgroupOps::None }
+	, vertexStride_{ 0 }
+	, instanceStride_{ 0 }
 	, inputs_{ }
 	, outputs_{ }
 	, locals_{ }
 	, bindings_{ }
 	, uniform_{ }
+	, pushConstant_{ }
 	, subpassInputs_{ }
+	, workgroupSize_{ 0, 0, 0 }
+	, workgroupSizeIds_{ UINT32_MAX, UINT32_MAX, UINT32_MAX }
+	, sharedVariables_{ }
+	, constants_{ }
+	, bufferPtrTypes_{ }
 {
 
 }
@@ -168,4 +216,198 @@ uint32 ShaderInfo::getMaxBindingIndex() const
 	return (it != bindings_.end()) ? it->slot : 0;
 }
 
+// ====================================================================================================================
+uint32 ShaderInfo::getBindingIndicesSize() const
+{
+	// Indices are packed as two 16-bit values per uint
+	return bindings_.empty() ? 0 : (((getMaxBindingIndex() + 2) / 2) * 4);
+}
+
+// ====================================================================================================================
+uint32 ShaderInfo::getPushConstantOffset() const
+{
+	// Push constant layout is [binding indices][vertex/instance buffer indices][push constant][promoted uniform]
+	const auto offset = getBindingIndicesSize() + (hasFlag(ShaderFlags::VertexPulling) ? 8 : 0);
+	if (!hasPushConstant()) {
+		return offset;
+	}
+	// BufferPtr members make the struct 8-byte aligned, which buffer_reference addresses require
+	const auto align = pushConstant_.type->userStruct.type->alignment();
+	return ((align > 1) && ((offset % align) != 0)) ? (offset + (align - (offset % align))) : offset;
+}
+
+// ====================================================================================================================
+uint32 ShaderInfo::getPushConstantEnd() const
+{
+	const auto pushSize = hasPushConstant() ? pushConstant_.type->userStruct.type->size() : 0;
+	return getPushConstantOffset() + pushSize;
+}
+
+// ====================================================================================================================
+uint32 ShaderInfo::getPushUniformOffset() const
+{
+	const auto offset = getPushConstantEnd();
+	if (!hasUniform()) {
+		return offset;
+	}
+	const auto align = uniform_.type->buffer.structType->userStruct.type->alignment();
+	return ((align > 1) && ((offset % align) != 0)) ? (offset + (align - (offset % align))) : offset;
+}
+
+// ====================================================================================================================
+void ShaderInfo::layoutVertexInputs(bool wordAlign)
+{
+	// Inputs are tightly packed in location order, with separate per-vertex and per-instance data
+	std::vector<InterfaceVariable*> order{};
+	for (auto& input : inputs_) {
+		order.push_back(&input);
+	}
+	std::sort(order.begin(), order.end(), [](const InterfaceVariable* left, const InterfaceVariable* right) {
+		return left->location < right->location;
+	});
+
+	// Each input is aligned to its component size, and each stride to the largest component alignment it contains
+	const auto alignUp = [](uint32 value, uint32 align) {
+		return ((value % align) != 0) ? (value + (align - (value % align))) : value;
+	};
+	vertexStride_ = 0;
+	instanceStride_ = 0;
+	uint32 vertexAlign{ 1 }, instanceAlign{ 1 };
+	for (const auto input : order) {
+		auto& stride = input->perInstance ? instanceStride_ : vertexStride_;
+		auto& maxAlign = input->perInstance ? instanceAlign : vertexAlign;
+		const auto align = input->componentAlignment();
+		input->offset = alignUp(stride, align);
+		stride = input->offset + input->dataSize();
+		if (wordAlign) {
+			stride = alignUp(stride, 4);
+		}
+		maxAlign = std::max(maxAlign, align);
+	}
+	vertexStride_ = alignUp(vertexStride_, vertexAlign);
+	instanceStride_ = alignUp(instanceStride_, instanceAlign);
+}
+
+// ====================================================================================================================
+void ShaderInfo::packLocals()
+{
+	// Locals can only share a slot if they have the same interpolation and the same component type
+	struct Slot final
+	{
+		bool flat;
+		BaseType baseType;
+		uint32 size;
+		uint32 used;
+	};
+	std::vector<Slot> slots{};
+
+	// Pack the widest locals first to reduce wasted components (stable to keep declaration order otherwise)
+	std::vector<LocalVariable*> order{};
+	for (auto& local : locals_) {
+		order.push_back(&local);
+	}
+	std::stable_sort(order.begin(), order.end(), [](const LocalVariable* left, const LocalVariable* right) {
+		return left->type->numeric.dims[0] > right->type->numeric.dims[0];
+	});
+
+	// First-fit into the existing slots
+	for (const auto local : order) {
+		const auto type = local->type;
+		const auto count = type->numeric.dims[0];
+		auto it = std::find_if(slots.begin(), slots.end(), [local, type, count](const Slot& slot) {
+			return (slot.flat == local->isFlat) && (slot.baseType == type->baseType) &&
+				(slot.size == type->numeric.size) && ((4 - slot.used) >= count);
+		});
+		if (it == slots.end()) {
+			slots.push_back({ local->isFlat, type->baseType, type->numeric.size, 0 });
+			it = slots.end() - 1;
+		}
+
+		local->location = uint32(std::distance(slots.begin(), it));
+		local->component = it->used;
+		it->used += count;
+	}
+}
+
+// ====================================================================================================================
+uint32 ShaderInfo::getLocalSlotCount() const
+{
+	const auto it =
+		std::max_element(locals_.begin(), locals_.end(), [](const LocalVariable& left, const LocalVariable& right) {
+			return left.location < right.location;
+		});
+	return (it != locals_.end()) ? (it->location + 1) : 0;
+}
+
+// ====================================================================================================================
+const SharedVariable* ShaderInfo::getSharedVariable(const string& name) const
+{
+	const auto it = std::find_if(sharedVariables_.begin(), sharedVariables_.end(), [&name](const SharedVariable& var) {
+		return var.name == name;
+	});
+	return (it != sharedVariables_.end()) ? &(*it) : nullptr;
+}
+
+// ====================================================================================================================
+uint32 ShaderInfo::getSharedSize() const
+{
+	uint32 size = 0;
+	for (const auto& var : sharedVariables_) {
+		const auto align = var.type->getLayoutAlignment();
+		if ((size % align) != 0) {
+			size += (align - (size % align));
+		}
+		size += var.dataSize();
+	}
+	return size;
+}
+
+// ====================================================================================================================
+const ConstantVariable* ShaderInfo::getConstant(const string& name) const
+{
+	const auto it = std::find_if(constants_.begin(), constants_.end(), [&name](const ConstantVariable& var) {
+		return var.name == name;
+	});
+	return (it != constants_.end()) ? &(*it) : nullptr;
+}
+
+// ====================================================================================================================
+ConstantVariable* ShaderInfo::getConstant(const string& name)
+{
+	const auto it = std::find_if(constants_.begin(), constants_.end(), [&name](const ConstantVariable& var) {
+		return var.name == name;
+	});
+	return (it != constants_.end()) ? &(*it) : nullptr;
+}
+
+// ====================================================================================================================
+const ConstantVariable* ShaderInfo::getConstant(uint32 id) const
+{
+	const auto it = std::find_if(constants_.begin(), constants_.end(), [id](const ConstantVariable& var) {
+		return var.id == id;
+	});
+	return (it != constants_.end()) ? &(*it) : nullptr;
+}
+
+// ====================================================================================================================
+void ShaderInfo::addBufferPtrType(const StructType* type, ShaderStages stage)
+{
+	const auto it = std::find_if(bufferPtrTypes_.begin(), bufferPtrTypes_.end(), [type](const BufferPtrType& ptr) {
+		return ptr.type == type;
+	});
+	if (it != bufferPtrTypes_.end()) {
+		it->stageMask |= stage;
+	}
+	else {
+		bufferPtrTypes_.push_back({ type, stage });
+	}
+}
+
+// ====================================================================================================================
+bool ShaderInfo::canUseEarlyFragmentTests() const
+{
+	return !hasFlag(ShaderFlags::FragmentDiscard) && !hasFlag(ShaderFlags::FragmentStorageWrite) &&
+		!hasFlag(ShaderFlags::FragmentDepthWrite);
+}
+
 } // namespace vsl
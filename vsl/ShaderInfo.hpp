@@ -29,7 +29,9 @@ enum class ShaderStages : uint32
 	TessEval = (1 << 2),
 	Geometry = (1 << 3),
 	Fragment = (1 << 4),
-	AllGraphics = Vertex | TessControl | TessEval | Geometry | Fragment
+	Compute = (1 << 5),
+	AllGraphics = Vertex | TessControl | TessEval | Geometry | Fragment,
+	AllStages = AllGraphics | Compute
 }; // enum class ShaderStages
 inline ShaderStages operator | (ShaderStages l, ShaderStages r) { return ShaderStages(uint16(l) | uint16(r)); }
 inline ShaderStages operator & (ShaderStages l, ShaderStages r) { return ShaderStages(uint16(l) & uint16(r)); }
@@ -45,22 +47,94 @@ ShaderStages StrToShaderStage(const string& str);
 string ShaderStageToStr(ShaderStages stage);
 
 
+// The kind of shader program, which is also the shader type code in the compiled output
+enum class ShaderKind : uint32
+{
+	Graphics = 1, // Vertex/fragment pipeline stages
+	Compute = 2   // Single compute stage
+}; // enum class ShaderKind
+
+
+// Flags describing shader behavior that affects the pipeline state the runtime can select
+enum class ShaderFlags : uint32
+{
+	None = 0,
+	FragmentDiscard = (1 << 0),       // The fragment stage contains a 'discard' statement
+	FragmentStorageWrite = (1 << 1),  // The fragment stage writes to storage resources (buffers, images, texels)
+	FragmentCoordRead = (1 << 2),     // The fragment stage reads $FragCoord
+	EarlyFragmentTests = (1 << 3),    // The fragment stage is generated with forced early fragment tests
+	FragmentDepthWrite = (1 << 4),    // The fragment stage writes $FragDepth
+	UniformPushConstant = (1 << 5),   // The uniform is placed in the push constant block instead of a buffer
+	BufferReferences = (1 << 6),      // The shader uses BufferPtr types (requires buffer device address)
+	VertexPulling = (1 << 7),         // Vertex inputs are fetched from a buffer instead of vertex attributes
+	Arithmetic16 = (1 << 8),          // The shader uses 16-bit arithmetic types (requires float16/int16 features)
+	Arithmetic8 = (1 << 9),           // The shader uses 8-bit arithmetic types (requires int8 feature)
+	Storage16 = (1 << 10),            // Structs contain 16-bit members (requires 16-bit storage features)
+	Storage8 = (1 << 11),             // Structs contain 8-bit members (requires 8-bit storage features)
+	Multiview = (1 << 12),            // The shader reads $ViewIndex (requires a multiview render pass)
+	PrimitiveShadingRate = (1 << 13), // The vertex stage writes $PrimitiveShadingRate (requires primitive VRS)
+	ShadingRateRead = (1 << 14)       // The fragment stage reads $ShadingRate (requires fragment shading rate)
+}; // enum class ShaderFlags
+inline ShaderFlags operator | (ShaderFlags l, ShaderFlags r) { return ShaderFlags(uint32(l) | uint32(r)); }
+inline ShaderFlags operator & (ShaderFlags l, ShaderFlags r) { return ShaderFlags(uint32(l) & uint32(r)); }
+inline ShaderFlags& operator |= (ShaderFlags& l, ShaderFlags r) {
+	l = l | r;
+	return l;
+}
+
+
+// Subgroup operation classes used by a shader (bit values match VkSubgroupFeatureFlagBits)
+enum class SubgroupOps : uint32
+{
+	None = 0,
+	Basic = (1 << 0),           // Subgroup size/invocation ids, elect, subgroup barriers
+	Vote = (1 << 1),            // All/any/all-equal votes
+	Arithmetic = (1 << 2),      // Reductions and inclusive/exclusive scans
+	Ballot = (1 << 3),          // Ballots and broadcasts
+	Shuffle = (1 << 4),         // Arbitrary and xor shuffles
+	ShuffleRelative = (1 << 5), // Up/down shuffles
+	Quad = (1 << 7)             // Quad broadcasts and swaps
+}; // enum class SubgroupOps
+inline SubgroupOps operator | (SubgroupOps l, SubgroupOps r) { return SubgroupOps(uint32(l) | uint32(r)); }
+inline SubgroupOps operator & (SubgroupOps l, SubgroupOps r) { return SubgroupOps(uint32(l) & uint32(r)); }
+
+
+// The declared direction of fragment depth writes, which allows hardware to keep hierarchical depth culling active
+enum class DepthMode : uint32
+{
+	None = 0,       // No mode declared, depth writes are treated as 'Any'
+	Any = 1,        // Written depth can have any value
+	Greater = 2,    // Written depth is greater than or equal to the rasterized depth
+	Less = 3,       // Written depth is less than or equal to the rasterized depth
+	Unchanged = 4   // Written depth is equal to the rasterized depth
+}; // enum class DepthMode
+DepthMode StrToDepthMode(const string& str);
+string DepthModeToStr(DepthMode mode);
+
+
 // Describes an interface variable for a shader (vertex input & fragment output)
 struct InterfaceVariable final
 {
 public:
-	InterfaceVariable() : name{}, location{}, type{}, arraySize{} { }
+	InterfaceVariable() : name{}, location{}, type{}, arraySize{}, format{}, perInstance{}, offset{} { }
 	InterfaceVariable(const string& name, uint32 location, const ShaderType* type, uint32 arrSize)
-		: name{ name }, location{ location }, type{ type }, arraySize{ arrSize }
+		: name{ name }, location{ location }, type{ type }, arraySize{ arrSize }, format{ nullptr }
+		, perInstance{ false }, offset{ 0 }
 	{ }
 
 	inline uint32 bindingCount() const { return type->getBindingCount() * arraySize; }
+	inline uint32 elementSize() const { return format ? format->getTexelSize() : type->getLayoutSize(); }
+	inline uint32 dataSize() const { return elementSize() * arraySize; }
+	inline uint32 componentAlignment() const { return format ? format->size : type->getLayoutAlignment(); }
 
 public:
 	string name;
 	uint32 location;
 	const ShaderType* type;
 	uint32 arraySize;
+	const TexelFormat* format; // Vertex storage format, or nullptr for the 32-bit format of the type
+	bool perInstance;          // If the vertex input advances per-instance instead of per-vertex
+	uint32 offset;             // Offset within the vertex (or instance) data
 }; // struct InterfaceVariable
 
 
@@ -68,16 +142,21 @@ public:
 struct BindingVariable final
 {
 public:
-	BindingVariable() : name{}, type{}, slot{}, stageMask{} { }
+	BindingVariable() : name{}, type{}, slot{}, stageMask{}, readMask{}, writeMask{} { }
 	BindingVariable(const string& name, const ShaderType* type, uint32 slot)
-		: name{ name }, type{ type }, slot{ slot }, stageMask{}
+		: name{ name }, type{ type }, slot{ slot }, stageMask{}, readMask{}, writeMask{}
 	{ }
 
+	inline bool isReadIn(ShaderStages stage) const { return bool(readMask & stage); }
+	inline bool isWrittenIn(ShaderStages stage) const { return bool(writeMask & stage); }
+
 public:
 	string name;
 	const ShaderType* type;
 	uint32 slot;
 	ShaderStages stageMask; // Shader stages that use the binding
+	ShaderStages readMask;  // Shader stages that read from the binding
+	ShaderStages writeMask; // Shader stages that write to the binding
 }; // struct BindingVariable
 
 
@@ -101,9 +180,9 @@ public:
 struct LocalVariable final
 {
 public:
-	LocalVariable() : name{}, pStage{}, type{ nullptr }, isFlat{} { }
+	LocalVariable() : name{}, pStage{}, type{ nullptr }, isFlat{}, location{ 0 }, component{ 0 } { }
 	LocalVariable(const string& name, ShaderStages pStage, const ShaderType* type, bool flat)
-		: name{ name }, pStage{ pStage }, type{ type }, isFlat{ flat }
+		: name{ name }, pStage{ pStage }, type{ type }, isFlat{ flat }, location{ 0 }, component{ 0 }
 	{ }
 
 public:
@@ -111,9 +190,61 @@ public:
 	ShaderStages pStage;
 	const ShaderType* type;
 	bool isFlat;
+	uint32 location;  // The packed interface slot
+	uint32 component; // The first component within the packed slot
 }; // struct LocalVariable
 
 
+// Describes a workgroup shared variable in a compute shader
+struct SharedVariable final
+{
+public:
+	SharedVariable() : name{}, type{ nullptr }, arraySize{ 0 } { }
+	SharedVariable(const string& name, const ShaderType* type, uint32 arraySize)
+		: name{ name }, type{ type }, arraySize{ arraySize }
+	{ }
+
+	inline uint32 dataSize() const { return type->getLayoutSize() * arraySize; }
+
+public:
+	string name;
+	const ShaderType* type;
+	uint32 arraySize;
+}; // struct SharedVariable
+
+
+// Describes a specialization constant, with a default value that can be overridden at pipeline creation
+struct ConstantVariable final
+{
+public:
+	ConstantVariable() : name{}, id{ 0 }, type{ nullptr }, value{ 0 }, baked{ false }, stageMask{ } { }
+	ConstantVariable(const string& name, uint32 id, const ShaderType* type, uint32 value)
+		: name{ name }, id{ id }, type{ type }, value{ value }, baked{ false }, stageMask{ ShaderStages::None }
+	{ }
+
+public:
+	string name;
+	uint32 id;               // The constant_id of the constant
+	const ShaderType* type;  // Always a 32-bit numeric scalar or bool
+	uint32 value;            // The raw bits of the default (or baked) value
+	bool baked;              // If the value is baked into the generated code for a variant (not specializable)
+	ShaderStages stageMask;  // The stages that use the constant
+}; // struct ConstantVariable
+
+
+// Describes a struct type pointed to by BufferPtr local variables
+struct BufferPtrType final
+{
+public:
+	BufferPtrType() : type{ nullptr }, stageMask{ ShaderStages::None } { }
+	BufferPtrType(const StructType* type, ShaderStages stageMask) : type{ type }, stageMask{ stageMask } { }
+
+public:
+	const StructType* type;  // The pointed-to struct type
+	ShaderStages stageMask;  // The stages that declare local pointers of the type
+}; // struct BufferPtrType
+
+
 // Contains information about a shader
 class ShaderInfo final
 {
@@ -121,13 +252,21 @@ public:
 	ShaderInfo();
 	~ShaderInfo();
 
+	DECL_GETTER_SETTER(ShaderKind, kind)
 	DECL_GETTER_SETTER(ShaderStages, stageMask)
+	DECL_GETTER_SETTER(ShaderFlags, flags)
+	DECL_GETTER_SETTER(DepthMode, depthMode)
+	DECL_GETTER_SETTER(SubgroupOps, subgroupOps)
 	DECL_GETTER_SETTER(std::vector<InterfaceVariable>&, inputs)
 	DECL_GETTER_SETTER(std::vector<InterfaceVariable>&, outputs)
 	DECL_GETTER_SETTER(std::vector<LocalVariable>&, locals)
 	DECL_GETTER_SETTER(std::vector<BindingVariable>&, bindings)
 	DECL_GETTER_SETTER(BindingVariable&, uniform)
+	DECL_GETTER_SETTER(BindingVariable&, pushConstant)
 	DECL_GETTER_SETTER(std::vector<SubpassInputVariable>&, subpassInputs)
+	DECL_GETTER_SETTER(std::vector<SharedVariable>&, sharedVariables)
+	DECL_GETTER_SETTER(std::vector<ConstantVariable>&, constants)
+	DECL_GETTER_SETTER(std::vector<BufferPtrType>&, bufferPtrTypes)
 
 	/* Interface Variables */
 	const InterfaceVariable* getInput(const string& name) const;
@@ -143,16 +282,73 @@ public:
 	BindingVariable* getBinding(const string& name);
 	BindingVariable* getBinding(uint32 slotIndex);
 	inline bool hasUniform() const { return !uniform_.name.empty(); }
+	inline bool hasPushConstant() const { return !pushConstant_.name.empty(); }
 	uint32 getMaxBindingIndex() const;
+	uint32 getBindingIndicesSize() const;
+	uint32 getPushConstantOffset() const;
+	uint32 getPushConstantEnd() const;
+	uint32 getPushUniformOffset() const;
+
+	/* Vertex Inputs */
+	void layoutVertexInputs(bool wordAlign);
+	inline uint32 vertexStride() const { return vertexStride_; }
+	inline uint32 instanceStride() const { return instanceStride_; }
+
+	/* Locals */
+	void packLocals();
+	uint32 getLocalSlotCount() const;
+
+	/* Compute */
+	inline bool isCompute() const { return kind_ == ShaderKind::Compute; }
+	inline const uint32* workgroupSize() const { return workgroupSize_; }
+	inline void workgroupSize(uint32 x, uint32 y, uint32 z) {
+		workgroupSize_[0] = x;
+		workgroupSize_[1] = y;
+		workgroupSize_[2] = z;
+	}
+	inline bool hasWorkgroupSize() const { return workgroupSize_[0] != 0; }
+	inline const uint32* workgroupSizeIds() const { return workgroupSizeIds_; } // UINT32_MAX for literal sizes
+	inline void workgroupSizeIds(uint32 x, uint32 y, uint32 z) {
+		workgroupSizeIds_[0] = x;
+		workgroupSizeIds_[1] = y;
+		workgroupSizeIds_[2] = z;
+	}
+	const SharedVariable* getSharedVariable(const string& name) const;
+	uint32 getSharedSize() const;
+
+	/* Constants */
+	const ConstantVariable* getConstant(const string& name) const;
+	const ConstantVariable* getConstant(uint32 id) const;
+	ConstantVariable* getConstant(const string& name);
+
+	/* Buffer Pointers */
+	void addBufferPtrType(const StructType* type, ShaderStages stage);
+
+	/* Flags */
+	inline bool hasFlag(ShaderFlags flag) const { return bool(flags_ & flag); }
+	inline bool hasSubgroupOps(SubgroupOps ops) const { return bool(subgroupOps_ & ops); }
+	bool canUseEarlyFragmentTests() const; // If the fragment stage has no side effects that require late tests
 
 private:
+	ShaderKind kind_;
 	ShaderStages stageMask_;
+	ShaderFlags flags_;
+	DepthMode depthMode_;
+	SubgroupOps subgroupOps_;
+	uint32 vertexStride_;
+	uint32 instanceStride_;
 	std::vector<InterfaceVariable> inputs_;
 	std::vector<InterfaceVariable> outputs_;
 	std::vector<LocalVariable> locals_;
 	std::vector<BindingVariable> bindings_;
 	BindingVariable uniform_;
+	BindingVariable pushConstant_;
 	std::vector<SubpassInputVariable> subpassInputs_;
+	uint32 workgroupSize_[3];
+	uint32 workgroupSizeIds_[3];
+	std::vector<SharedVariable> sharedVariables_;
+	std::vector<ConstantVariable> constants_;
+	std::vector<BufferPtrType> bufferPtrTypes_;
 
 	VSL_NO_COPY(ShaderInfo)
 	VSL_NO_MOVE(ShaderInfo)
@@ -48,17 +48,24 @@ uint32 TexelRankGetComponentCount(TexelRank rank)
 
 // ====================================================================================================================
 // ====================================================================================================================
-StructType::StructType(const string& name, const std::vector<Member>& members)
+StructType::StructType(const string& name, const std::vector<Member>& members, bool reorder)
 	: name_{ name }
 	, members_{ members }
 	, offsets_{ }
 	, size_{ 0 }
 	, alignment_{ 0 }
 {
+	// Placing members in order of decreasing alignment removes all padding between members
+	if (reorder) {
+		std::stable_sort(members_.begin(), members_.end(), [](const Member& left, const Member& right) {
+			return left.type->getLayoutAlignment() > right.type->getLayoutAlignment();
+		});
+	}
+
 	if (!members.empty()) {
 		for (const auto& mem : members_) {
 			// Align
-			const auto align = mem.type->numeric.size;
+			const auto align = mem.type->getLayoutAlignment();
 			if ((size_ % align) != 0) {
 				size_ += (align - (size_ % align));
 			}
@@ -68,7 +75,7 @@ StructType::StructType(const string& name, const std::vector<Member>& members)
 
 			// Add member
 			offsets_.push_back(size_);
-			size_ += (mem.type->numeric.size * mem.type->numeric.dims[0] * mem.type->numeric.dims[1] * mem.arraySize);
+			size_ += (mem.type->getLayoutSize() * mem.arraySize);
 		}
 
 		// Final size alignment
@@ -108,15 +115,25 @@ bool TexelFormat::isSame(const TexelFormat* format) const
 // ====================================================================================================================
 string TexelFormat::getVSLName() const
 {
+	// Packed formats have fixed names
+	if (type == TexelType::PackedFloat) {
+		return "r11g11b10f";
+	}
+	if (type == TexelType::PackedUNorm) {
+		return "rgb10a2";
+	}
+
 	// Base name
 	string base{ "BAD_TYPE" };
 	switch (type)
 	{
 	case TexelType::Signed: base = (size == 4) ? "int" : "BAD_SIZE"; break;
 	case TexelType::Unsigned: base = (size == 4) ? "uint" : "BAD_SIZE"; break;
-	case TexelType::Float: base = (size == 4) ? "float" : "BAD_SIZE"; break;
+	case TexelType::Float: base = (size == 4) ? "float" : (size == 2) ? "half" : "BAD_SIZE"; break;
 	case TexelType::UNorm: base = (size == 1) ? "u8norm" : (size == 2) ? "u16norm" : "BAD_SIZE"; break;
 	case TexelType::SNorm: base = (size == 1) ? "s8norm" : (size == 2) ? "s16norm" : "BAD_SIZE"; break;
+	case TexelType::PackedFloat:
+	case TexelType::PackedUNorm: break; // Returned above
 	}
 
 	// Count
@@ -134,6 +151,14 @@ string TexelFormat::getVSLName() const
 // ====================================================================================================================
 string TexelFormat::getGLSLName() const
 {
+	// Packed formats have fixed names
+	if (type == TexelType::PackedFloat) {
+		return "r11f_g11f_b10f";
+	}
+	if (type == TexelType::PackedUNorm) {
+		return "rgb10_a2";
+	}
+
 	// Base text
 	string base{ "BAD_COUNT" };
 	switch (count)
@@ -149,9 +174,11 @@ string TexelFormat::getGLSLName() const
 	{
 	case TexelType::Signed: typeStr = (size == 4) ? "32i" : "BAD_SIZE"; break;
 	case TexelType::Unsigned: typeStr = (size == 4) ? "32ui" : "BAD_SIZE"; break;
-	case TexelType::Float: typeStr = (size == 4) ? "32f" : "BAD_SIZE"; break;
-	case TexelType::UNorm: typeStr = (size == 1) ? "8" : (size == 1) ? "16" : "BAD_SIZE"; break;
-	case TexelType::SNorm: typeStr = (size == 1) ? "8_snorm" : (size == 1) ? "16_snorm" : "BAD_SIZE"; break;
+	case TexelType::Float: typeStr = (size == 4) ? "32f" : (size == 2) ? "16f" : "BAD_SIZE"; break;
+	case TexelType::UNorm: typeStr = (size == 1) ? "8" : (size == 2) ? "16" : "BAD_SIZE"; break;
+	case TexelType::SNorm: typeStr = (size == 1) ? "8_snorm" : (size == 2) ? "16_snorm" : "BAD_SIZE"; break;
+	case TexelType::PackedFloat:
+	case TexelType::PackedUNorm: break; // Returned above
 	}
 
 	// Combine
@@ -175,7 +202,7 @@ const ShaderType* TexelFormat::asDataType() const
 {
 	const auto& bit = TypeList::BuiltinTypes();
 	if (isFloatingType()) {
-		return &bit.at((count == 1) ? "float" : (count == 2) ? "float2" : "float4");
+		return &bit.at((count == 1) ? "float" : (count == 2) ? "float2" : (count == 3) ? "float3" : "float4");
 	}
 	else if (isSigned()) {
 		return &bit.at((count == 1) ? "int" : (count == 2) ? "int2" : "int4");
@@ -214,6 +241,7 @@ bool ShaderType::isSame(const ShaderType* otherType) const
 	case BaseType::SPInput: return texel.format->isSame(otherType->texel.format);
 	case BaseType::Uniform: return (buffer.structType == otherType->buffer.structType);
 	case BaseType::Struct: return (userStruct.type->name() == otherType->userStruct.type->name());
+	case BaseType::BufferPtr: return (buffer.structType == otherType->buffer.structType);
 	default: return false;
 	}
 }
@@ -271,13 +299,38 @@ string ShaderType::getVSLName() const
 	case BaseType::Boolean: return
 		(numeric.dims[0] == 1) ? "bool" : (numeric.dims[0] == 2) ? "bool2" :
 		(numeric.dims[0] == 3) ? "bool3" : "bool4";
-	case BaseType::Signed: return (numeric.size != 4) ? "BAD_SIGNED_TYPE_SIZE" :
-		(numeric.dims[0] == 1) ? "int" : (numeric.dims[0] == 2) ? "int2" :
-		(numeric.dims[0] == 3) ? "int3" : "int4";
-	case BaseType::Unsigned: return (numeric.size != 4) ? "BAD_UNSIGNED_TYPE_SIZE" :
-		(numeric.dims[0] == 1) ? "uint" : (numeric.dims[0] == 2) ? "uint2" :
-		(numeric.dims[0] == 3) ? "uint3" : "uint4";
+	case BaseType::Signed: {
+		if (numeric.size == 2) {
+			return (numeric.dims[0] == 1) ? "short" : (numeric.dims[0] == 2) ? "short2" :
+				(numeric.dims[0] == 3) ? "short3" : "short4";
+		}
+		if (numeric.size == 1) {
+			return (numeric.dims[0] == 1) ? "byte" : (numeric.dims[0] == 2) ? "byte2" :
+				(numeric.dims[0] == 3) ? "byte3" : "byte4";
+		}
+		return (numeric.size != 4) ? "BAD_SIGNED_TYPE_SIZE" :
+			(numeric.dims[0] == 1) ? "int" : (numeric.dims[0] == 2) ? "int2" :
+			(numeric.dims[0] == 3) ? "int3" : "int4";
+	} break;
+	case BaseType::Unsigned: {
+		if (numeric.size == 2) {
+			return (numeric.dims[0] == 1) ? "ushort" : (numeric.dims[0] == 2) ? "ushort2" :
+				(numeric.dims[0] == 3) ? "ushort3" : "ushort4";
+		}
+		if (numeric.size == 1) {
+			return (numeric.dims[0] == 1) ? "ubyte" : (numeric.dims[0] == 2) ? "ubyte2" :
+				(numeric.dims[0] == 3) ? "ubyte3" : "ubyte4";
+		}
+		return (numeric.size != 4) ? "BAD_UNSIGNED_TYPE_SIZE" :
+			(numeric.dims[0] == 1) ? "uint" : (numeric.dims[0] == 2) ? "uint2" :
+			(numeric.dims[0] == 3) ? "uint3" : "uint4";
+	} break;
 	case BaseType::Float: {
+		if (numeric.size == 2) {
+			return (numeric.dims[1] != 1) ? "BAD_FLOAT_TYPE_SIZE" :
+				(numeric.dims[0] == 1) ? "half" : (numeric.dims[0] == 2) ? "half2" :
+				(numeric.dims[0] == 3) ? "half3" : "half4";
+		}
 		if (numeric.size != 4) {
 			return "BAD_FLOAT_TYPE_SIZE";
 		}
@@ -300,6 +353,7 @@ string ShaderType::getVSLName() const
 	case BaseType::SPInput: return texel.format->getVSLName();
 	case BaseType::Uniform: return buffer.structType->userStruct.type->name();
 	case BaseType::Struct: return buffer.structType->userStruct.type->name();
+	case BaseType::BufferPtr: return "BufferPtr<" + buffer.structType->userStruct.type->name() + ">";
 	default: return "INVALID_TYPE";
 	}
 }
@@ -319,13 +373,38 @@ string ShaderType::getGLSLName() const
 	case BaseType::Boolean: return
 		(numeric.dims[0] == 1) ? "bool" : (numeric.dims[0] == 2) ? "bvec2" :
 		(numeric.dims[0] == 3) ? "bvec3" : "bvec4";
-	case BaseType::Signed: return (numeric.size != 4) ? "BAD_SIGNED_TYPE_SIZE" :
-		(numeric.dims[0] == 1) ? "int" : (numeric.dims[0] == 2) ? "ivec2" :
-		(numeric.dims[0] == 3) ? "ivec3" : "ivec4";
-	case BaseType::Unsigned: return (numeric.size != 4) ? "BAD_UNSIGNED_TYPE_SIZE" :
-		(numeric.dims[0] == 1) ? "uint" : (numeric.dims[0] == 2) ? "uvec2" :
-		(numeric.dims[0] == 3) ? "uvec3" : "uvec4";
+	case BaseType::Signed: {
+		if (numeric.size == 2) {
+			return (numeric.dims[0] == 1) ? "int16_t" : (numeric.dims[0] == 2) ? "i16vec2" :
+				(numeric.dims[0] == 3) ? "i16vec3" : "i16vec4";
+		}
+		if (numeric.size == 1) {
+			return (numeric.dims[0] == 1) ? "int8_t" : (numeric.dims[0] == 2) ? "i8vec2" :
+				(numeric.dims[0] == 3) ? "i8vec3" : "i8vec4";
+		}
+		return (numeric.size != 4) ? "BAD_SIGNED_TYPE_SIZE" :
+			(numeric.dims[0] == 1) ? "int" : (numeric.dims[0] == 2) ? "ivec2" :
+			(numeric.dims[0] == 3) ? "ivec3" : "ivec4";
+	} break;
+	case BaseType::Unsigned: {
+		if (numeric.size == 2) {
+			return (numeric.dims[0] == 1) ? "uint16_t" : (numeric.dims[0] == 2) ? "u16vec2" :
+				(numeric.dims[0] == 3) ? "u16vec3" : "u16vec4";
+		}
+		if (numeric.size == 1) {
+			return (numeric.dims[0] == 1) ? "uint8_t" : (numeric.dims[0] == 2) ? "u8vec2" :
+				(numeric.dims[0] == 3) ? "u8vec3" : "u8vec4";
+		}
+		return (numeric.size != 4) ? "BAD_UNSIGNED_TYPE_SIZE" :
+			(numeric.dims[0] == 1) ? "uint" : (numeric.dims[0] == 2) ? "uvec2" :
+			(numeric.dims[0] == 3) ? "uvec3" : "uvec4";
+	} break;
 	case BaseType::Float: {
+		if (numeric.size == 2) {
+			return (numeric.dims[1] != 1) ? "BAD_FLOAT_TYPE_SIZE" :
+				(numeric.dims[0] == 1) ? "float16_t" : (numeric.dims[0] == 2) ? "f16vec2" :
+				(numeric.dims[0] == 3) ? "f16vec3" : "f16vec4";
+		}
 		if (numeric.size != 4) {
 			return "BAD_FLOAT_TYPE_SIZE";
 		}
@@ -348,6 +427,7 @@ string ShaderType::getGLSLName() const
 	case BaseType::SPInput: return texel.format->getGLSLPrefix() + "subpassInput";
 	case BaseType::Uniform: return buffer.structType->userStruct.type->name() + "_t";
 	case BaseType::Struct: return buffer.structType->userStruct.type->name() + "_t";
+	case BaseType::BufferPtr: return buffer.structType->userStruct.type->name() + "_ptr";
 	default: return "INVALID_TYPE";
 	}
 }
@@ -363,6 +443,21 @@ uint32 ShaderType::getBindingCount() const
 	return slotCount * numeric.dims[1];
 }
 
+// ====================================================================================================================
+uint32 ShaderType::getLayoutSize() const
+{
+	if (isBufferPtr()) {
+		return 8; // 64-bit device address
+	}
+	return numeric.size * numeric.dims[0] * numeric.dims[1];
+}
+
+// ====================================================================================================================
+uint32 ShaderType::getLayoutAlignment() const
+{
+	return isBufferPtr() ? 8 : numeric.size;
+}
+
 
 // ====================================================================================================================
 // ====================================================================================================================
@@ -553,6 +648,9 @@ const ShaderType* TypeList::ParseGenericType(const string& baseType)
 	else if (baseType == "RWTexels") {
 		genType = { BaseType::RWTexels, TexelRank::Buffer, nullptr };
 	}
+	else if (baseType == "BufferPtr") {
+		genType = { BaseType::BufferPtr, nullptr };
+	}
 	else {
 		return nullptr;
 	}
@@ -621,6 +719,18 @@ TypeList::TypeMap TypeList::BuiltinTypes_ {
 	{ "float2x3", { BaseType::Float, 4, 3, 2 } }, { "float3x2", { BaseType::Float, 4, 2, 3 } },
 	{ "float2x4", { BaseType::Float, 4, 4, 2 } }, { "float4x2", { BaseType::Float, 4, 2, 4 } },
 	{ "float3x4", { BaseType::Float, 4, 4, 3 } }, { "float4x3", { BaseType::Float, 4, 3, 4 } },
+	// 16-bit
+	{ "short",  { BaseType::Signed, 2, 1, 1 } }, { "short2", { BaseType::Signed, 2, 2, 1 } },
+	{ "short3", { BaseType::Signed, 2, 3, 1 } }, { "short4", { BaseType::Signed, 2, 4, 1 } },
+	{ "ushort",  { BaseType::Unsigned, 2, 1, 1 } }, { "ushort2", { BaseType::Unsigned, 2, 2, 1 } },
+	{ "ushort3", { BaseType::Unsigned, 2, 3, 1 } }, { "ushort4", { BaseType::Unsigned, 2, 4, 1 } },
+	{ "half",  { BaseType::Float, 2, 1, 1 } }, { "half2", { BaseType::Float, 2, 2, 1 } },
+	{ "half3", { BaseType::Float, 2, 3, 1 } }, { "half4", { BaseType::Float, 2, 4, 1 } },
+	// 8-bit
+	{ "byte",  { BaseType::Signed, 1, 1, 1 } }, { "byte2", { BaseType::Signed, 1, 2, 1 } },
+	{ "byte3", { BaseType::Signed, 1, 3, 1 } }, { "byte4", { BaseType::Signed, 1, 4, 1 } },
+	{ "ubyte",  { BaseType::Unsigned, 1, 1, 1 } }, { "ubyte2", { BaseType::Unsigned, 1, 2, 1 } },
+	{ "ubyte3", { BaseType::Unsigned, 1, 3, 1 } }, { "ubyte4", { BaseType::Unsigned, 1, 4, 1 } },
 };
 TypeList::FormatMap TypeList::Formats_ {
 	// Signed
@@ -642,6 +752,12 @@ TypeList::FormatMap TypeList::Formats_ {
 	{ "s8norm4", { TexelType::SNorm, 1, 4 } },
 	{ "s16norm", { TexelType::SNorm, 2, 1 } }, { "s16norm2", { TexelType::SNorm, 2, 2 } },
 	{ "s16norm4", { TexelType::SNorm, 2, 4 } },
+	// Half
+	{ "half", { TexelType::Float, 2, 1 } }, { "half2", { TexelType::Float, 2, 2 } },
+	{ "half4", { TexelType::Float, 2, 4 } },
+	// Packed
+	{ "r11g11b10f", { TexelType::PackedFloat, 4, 3 } },
+	{ "rgb10a2", { TexelType::PackedUNorm, 4, 4 } },
 };
 TypeList::TypeMap TypeList::GenericTypes_{ };
 
@@ -32,9 +32,10 @@ enum class BaseType : uint32
 	SPInput  = 11,  // Vk input attachment, glsl `[ ui]subpassInput`
 	Uniform  = 12,  // Vk uniform buffer, glsl `uniform <name> { ... }`
 	Struct   = 13,  // User-defined POD struct
+	BufferPtr = 14, // Buffer device address, glsl `layout(buffer_reference) buffer <name> { ... }`
 
 	// Max value
-	MAX = Struct
+	MAX = BufferPtr
 }; // enum class BaseType
 
 
@@ -50,7 +51,8 @@ public:
 		const ShaderType* type;
 	}; // struct Member
 
-	StructType(const string& name, const std::vector<Member>& members);
+	// If 'reorder' is true, the members are reordered to minimize the padding in the struct layout
+	StructType(const string& name, const std::vector<Member>& members, bool reorder = false);
 	StructType() : StructType("INVALID", {}) { }
 	~StructType() { }
 
@@ -101,8 +103,10 @@ enum class TexelType : uint32
 	Float    = 2,
 	UNorm    = 3,
 	SNorm    = 4,
+	PackedFloat = 5, // Unsigned 11/11/10-bit floats packed in one 32-bit word (size is the whole texel)
+	PackedUNorm = 6, // 10/10/10/2-bit normalized values packed in one 32-bit word (size is the whole texel)
 
-	MAX = SNorm
+	MAX = PackedUNorm
 };
 
 
@@ -121,10 +125,14 @@ public:
 	inline bool isFloat() const { return type == TexelType::Float; }
 	inline bool isUNorm() const { return type == TexelType::UNorm; }
 	inline bool isSNorm() const { return type == TexelType::SNorm; }
+	inline bool isPacked() const { return (type == TexelType::PackedFloat) || (type == TexelType::PackedUNorm); }
 	inline bool isIntegerType() const { return isSigned() || isUnsigned(); }
-	inline bool isFloatingType() const { return isFloat() || isUNorm() || isSNorm(); }
+	inline bool isFloatingType() const { return isFloat() || isUNorm() || isSNorm() || isPacked(); }
 	inline bool isNormlizedType() const { return isUNorm() || isSNorm(); }
 
+	/* Size */
+	inline uint32 getTexelSize() const { return isPacked() ? size : (size * count); }
+
 	/* Type Check */
 	bool isSame(const TexelFormat* format) const;
 
@@ -183,6 +191,7 @@ public:
 	inline bool isSPInput() const  { return baseType == BaseType::SPInput; }
 	inline bool isUniform() const  { return baseType == BaseType::Uniform; }
 	inline bool isStruct() const   { return baseType == BaseType::Struct; }
+	inline bool isBufferPtr() const { return baseType == BaseType::BufferPtr; }
 
 	/* Composite Type Checks */
 	inline bool isInteger() const     { return isSigned() || isUnsigned(); }
@@ -210,6 +219,8 @@ public:
 
 	/* Type-Specific Functions */
 	uint32 getBindingCount() const;
+	uint32 getLayoutSize() const;      // Size within a scalar block layout (numerics and buffer pointers)
+	uint32 getLayoutAlignment() const; // Alignment within a scalar block layout (numerics and buffer pointers)
 
 	/* Operators */
 	inline bool operator == (const ShaderType& r) const { return (this == &r) || isSame(&r); }
@@ -11,7 +11,8 @@
 #include <iostream>
 
 
-bool ParseCommandLine(int argc, const char* argv[], bool* help, vsl::CompileOptions* options);
+bool ParseCommandLine(int argc, const char* argv[], bool* help, vsl::CompileOptions* options,
+	std::vector<vsl::ShaderVariant>* variants);
 void PrintHelp(const char* const arg0);
 
 int main(int argc, char* argv[])
@@ -26,8 +27,9 @@ int main(int argc, char* argv[])
 
 	// Try to parse command line
 	CompileOptions options{};
+	std::vector<ShaderVariant> variants{};
 	bool help{ false };
-	if (!ParseCommandLine(argc, (const char**)argv, &help, &options)) {
+	if (!ParseCommandLine(argc, (const char**)argv, &help, &options, &variants)) {
 		return 2;
 	}
 	if (help) {
@@ -47,6 +49,14 @@ int main(int argc, char* argv[])
 			std::cerr << " - " << err.message() << std::endl;
 			return 3;
 		}
+		if (!variants.empty()) {
+			if (!shader.compileVariants(variants)) {
+				const auto& err = shader.lastError();
+				std::cerr << "Failed to compile variants - " << err.message() << std::endl;
+				return 5;
+			}
+			return 0;
+		}
 		if (!shader.generate()) {
 			const auto& err = shader.lastError();
 			std::cerr << "Failed to generate - " << err.message() << std::endl;
@@ -8,6 +8,7 @@
 
 #include "../vsl/Shader.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 
@@ -44,12 +45,14 @@ static std::tuple<bool, std::string, std::string, std::string> normalizeArg(cons
 
 // ====================================================================================================================
 #define ERROR(msg) { std::cerr << msg << std::endl; return false; }
-bool ParseCommandLine(int argc, const char* argv[], bool* help, vsl::CompileOptions* options)
+bool ParseCommandLine(int argc, const char* argv[], bool* help, vsl::CompileOptions* options,
+	std::vector<vsl::ShaderVariant>* variants)
 {
 	using namespace vsl;
 
 	*options = {};
 	*help = false;
+	variants->clear();
 
 	// Default output file
 	const auto inputPath{ fs::absolute(fs::path{ argv[argc - 1] }) };
@@ -136,6 +139,51 @@ bool ParseCommandLine(int argc, const char* argv[], bool* help, vsl::CompileOpti
 		else if (name == "no-compile") {
 			options->noCompile(true);
 		}
+		else if (name == "early-tests") {
+			options->earlyFragmentTests(true);
+		}
+		else if (name == "reorder-structs") {
+			options->reorderStructs(true);
+		}
+		else if (name == "push-uniform") {
+			options->promoteUniform(true);
+		}
+		else if (name == "vertex-pulling") {
+			options->vertexPulling(true);
+		}
+		else if (name == "relaxed-precision") {
+			options->relaxedPrecision(true);
+		}
+		else if (name == "push-size") {
+			char* endPtr;
+			const auto size = std::strtoul(value.c_str(), &endPtr, 10);
+			if (value.empty() || (endPtr == value.c_str())) {
+				ERROR("Invalid numeric value for push constant size argument");
+			}
+			if ((size == 0) || ((size % 4) != 0) || (size > UINT16_MAX)) {
+				ERROR("Push constant size must be a non-zero multiple of 4 no larger than 65535");
+			}
+			options->pushConstantSize(uint32(size));
+		}
+		else if (name == "variant") { // Format: <name>:<const>=<value>[,<const>=<value>...]
+			const auto nameIndex = value.find(':');
+			if (value.empty() || (nameIndex == string::npos) || (nameIndex == 0)) {
+				ERROR("Invalid variant argument, expected --variant=<name>:<const>=<value>[,...]");
+			}
+			ShaderVariant variant{ value.substr(0, nameIndex), {} };
+			size_t start = nameIndex + 1;
+			while (start <= value.length()) {
+				const auto end = std::min(value.find(',', start), value.length());
+				const auto pair = value.substr(start, end - start);
+				const auto eqIndex = pair.find('=');
+				if ((eqIndex == string::npos) || (eqIndex == 0) || (eqIndex == (pair.length() - 1))) {
+					ERROR(mkstr("Invalid constant value '%s' for variant '%s'", pair.c_str(), variant.name.c_str()));
+				}
+				variant.values.push_back({ pair.substr(0, eqIndex), pair.substr(eqIndex + 1) });
+				start = end + 1;
+			}
+			variants->push_back(variant);
+		}
 		else if (isFlag) {
 			std::cout << "Unknown argument '" << name << "' (from " << argv[i] << ")" << std::endl;
 		}
@@ -170,5 +218,22 @@ void PrintHelp(const char* const arg0)
 		<< "                            - spirv  -  Saves the separate SPIR-V modules.\n"
 		<< "    --no-compile      - Disable final bytecode compilation and file output.\n"
 		<< "                        This will only perform validation on the shader.\n"
+		<< "    --early-tests     - Force early fragment tests when the fragment stage has no side\n"
+		<< "                        effects (no discard, storage writes, or depth writes).\n"
+		<< "    --reorder-structs - Reorder struct members to minimize padding. The final member order\n"
+		<< "                        is reported in the reflection info.\n"
+		<< "    --push-uniform    - Place the uniform in push constants if it fits in the push constant\n"
+		<< "                        budget along with the binding indices.\n"
+		<< "    --vertex-pulling  - Fetch vertex inputs from a bindless buffer indexed with $VertexIndex,\n"
+		<< "                        instead of using fixed-function vertex attributes.\n"
+		<< "    --relaxed-precision\n"
+		<< "                      - Declare function-local float values as mediump, allowing the driver to\n"
+		<< "                        evaluate them at reduced precision.\n"
+		<< "    --push-size=<n>   - Set the push constant budget in bytes (default " 
+			<< vsl::CompileOptions::DefaultPushConstantSize << ").\n"
+		<< "    --variant=<name>:<const>=<value>[,<const>=<value>...]\n"
+		<< "                      - Compile a variant with the given specialization constants baked in, written\n"
+		<< "                        to '<output>.<name>.vbc'. Can be given multiple times, identical variants\n"
+		<< "                        are only compiled once.\n"
 		<< std::endl;
 }